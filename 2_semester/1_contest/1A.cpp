@@ -1,13 +1,193 @@
-#include <iostream>
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <numbers>
 #include <numeric>
 #include <queue>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
 template <class VType = size_t, class EType = std::pair<VType, VType>>
 class Graph {
  public:
-  virtual std::vector<VType>& GetNeighbors(const VType&) = 0;
+  using VertexType = VType;
+  using EdgeType = EType;
+  virtual std::span<VType> GetNeighbors(const VType&) = 0;
   virtual size_t VertexCount() = 0;
   virtual size_t EdgeCount() = 0;
   virtual const std::vector<VType>& Vertices() = 0;
@@ -18,7 +198,7 @@ class Graph {
 
 template <class VType = size_t, class EType = std::pair<VType, VType>,
           bool ordered = false>
-class ListGraph : public Graph<VType, EType> {
+class ListGraph final : public Graph<VType, EType> {
  public:
   ListGraph(const std::vector<VType>& vertices, const std::vector<EType>& edges)
       : kVertexCount(vertices.size()),
@@ -31,7 +211,7 @@ class ListGraph : public Graph<VType, EType> {
       }
     }
   }
-  std::vector<VType>& GetNeighbors(const VType& vertex) override {
+  std::span<VType> GetNeighbors(const VType& vertex) override {
     return data_[vertex];
   }
   size_t VertexCount() override { return kVertexCount; }
@@ -52,21 +232,442 @@ class ListGraph : public Graph<VType, EType> {
   std::vector<VType> vertices_;
 };
 
+template <class VType = size_t, class EType = std::pair<VType, VType>,
+          bool ordered = false>
+class CSRListGraph final : public Graph<VType, EType> {
+  static_assert(std::is_integral_v<VType>, "CSR storage needs dense ids");
+
+ public:
+  CSRListGraph(const std::vector<VType>& vertices,
+               const std::vector<EType>& edges)
+      : kVertexCount(vertices.size()),
+        kEdgeCount(edges.size()),
+        vertices_(vertices) {
+    VType max_vertex = 0;
+    for (VType vertex : vertices) {
+      max_vertex = std::max(max_vertex, vertex);
+    }
+    for (auto edge : edges) {
+      max_vertex = std::max({max_vertex, edge.first, edge.second});
+    }
+    offsets_.assign(static_cast<size_t>(max_vertex) + 2, 0);
+    for (auto edge : edges) {
+      ++offsets_[edge.first];
+      if constexpr (!ordered) {
+        ++offsets_[edge.second];
+      }
+    }
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    neighbours_.resize(offsets_.back());
+    for (size_t i = edges.size(); i > 0; i--) {
+      const EType& edge = edges[i - 1];
+      if constexpr (!ordered) {
+        neighbours_[--offsets_[edge.second]] = edge.first;
+      }
+      neighbours_[--offsets_[edge.first]] = edge.second;
+    }
+  }
+  std::span<VType> GetNeighbors(const VType& vertex) override {
+    return {neighbours_.data() + offsets_[vertex],
+            neighbours_.data() + offsets_[vertex + 1]};
+  }
+  size_t VertexCount() override { return kVertexCount; }
+  size_t EdgeCount() override { return kEdgeCount; }
+  const std::vector<VType>& Vertices() override { return vertices_; }
+  typename std::vector<VType>::iterator Begin(const VType& vertex) override {
+    return neighbours_.begin() + offsets_[vertex];
+  }
+  typename std::vector<VType>::iterator End(const VType& vertex) override {
+    return neighbours_.begin() + offsets_[vertex + 1];
+  }
+  size_t ByteSize() const {
+    return offsets_.size() * sizeof(size_t) +
+           neighbours_.size() * sizeof(VType);
+  }
+  ~CSRListGraph() = default;
+
+ private:
+  std::vector<size_t> offsets_;
+  std::vector<VType> neighbours_;
+  const size_t kVertexCount;
+  const size_t kEdgeCount;
+  std::vector<VType> vertices_;
+};
+
+// Appends value as a base-128 varint: seven bits per byte, low bits first,
+// with the high bit set on every byte but the last.
+void PutVarint(std::vector<uint8_t>& bytes, uint64_t value) {
+  while (value >= 0x80) {
+    bytes.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  bytes.push_back(static_cast<uint8_t>(value));
+}
+
+inline uint64_t GetVarint(const uint8_t*& cursor) {
+  uint64_t value = *cursor++;
+  if (value < 0x80) {
+    return value;
+  }
+  value &= 0x7f;
+  for (unsigned shift = 7;; shift += 7) {
+    uint64_t byte = *cursor++;
+    value |= (byte & 0x7f) << shift;
+    if (byte < 0x80) {
+      return value;
+    }
+  }
+}
+
+// Sorted adjacency lists gap encoded as varints: the first neighbour is
+// stored as its zigzagged difference from the vertex, every other one as
+// its difference from the previous. GetNeighbors decodes on the fly, so it
+// serves the searches that only walk the lists, such as BidirectionalBFS
+// and MultiSourceBFS; neighbours come back in increasing order.
+template <class VType = size_t, class EType = std::pair<VType, VType>,
+          bool ordered = false>
+class CompressedCSRGraph {
+  static_assert(std::is_integral_v<VType>, "CSR storage needs dense ids");
+
+ public:
+  using VertexType = VType;
+  using EdgeType = EType;
+
+  class Neighbours {
+   public:
+    class Iterator {
+     public:
+      using value_type = VType;
+      using difference_type = std::ptrdiff_t;
+
+      Iterator() = default;
+      Iterator(const uint8_t* cursor, const uint8_t* end, uint64_t vertex)
+          : cursor_(cursor), next_(cursor), end_(end) {
+        if (cursor_ != end_) {
+          uint64_t gap = GetVarint(next_);
+          value_ = vertex + ((gap >> 1) ^ (0 - (gap & 1)));
+        }
+      }
+      VType operator*() const { return static_cast<VType>(value_); }
+      Iterator& operator++() {
+        cursor_ = next_;
+        if (cursor_ != end_) {
+          value_ += GetVarint(next_);
+        }
+        return *this;
+      }
+      Iterator operator++(int) {
+        Iterator previous = *this;
+        ++*this;
+        return previous;
+      }
+      bool operator==(const Iterator& other) const {
+        return cursor_ == other.cursor_;
+      }
+
+     private:
+      const uint8_t* cursor_ = nullptr;
+      const uint8_t* next_ = nullptr;
+      const uint8_t* end_ = nullptr;
+      uint64_t value_ = 0;
+    };
+
+    Neighbours(const uint8_t* begin, const uint8_t* end, uint64_t vertex)
+        : begin_(begin), end_(end), vertex_(vertex) {}
+    Iterator begin() const { return {begin_, end_, vertex_}; }
+    Iterator end() const { return {end_, end_, vertex_}; }
+
+   private:
+    const uint8_t* begin_;
+    const uint8_t* end_;
+    uint64_t vertex_;
+  };
+
+  CompressedCSRGraph(const std::vector<VType>& vertices,
+                     const std::vector<EType>& edges)
+      : kVertexCount(vertices.size()),
+        kEdgeCount(edges.size()),
+        vertices_(vertices) {
+    VType max_vertex = 0;
+    for (VType vertex : vertices) {
+      max_vertex = std::max(max_vertex, vertex);
+    }
+    for (auto edge : edges) {
+      max_vertex = std::max({max_vertex, edge.first, edge.second});
+    }
+    std::vector<size_t> offsets(static_cast<size_t>(max_vertex) + 2, 0);
+    for (auto edge : edges) {
+      ++offsets[edge.first];
+      if constexpr (!ordered) {
+        ++offsets[edge.second];
+      }
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<uint64_t> neighbours(offsets.back());
+    for (const EType& edge : edges) {
+      if constexpr (!ordered) {
+        neighbours[--offsets[edge.second]] = edge.first;
+      }
+      neighbours[--offsets[edge.first]] = edge.second;
+    }
+    offsets_.assign(offsets.size(), 0);
+    for (size_t vertex = 0; vertex + 1 < offsets.size(); vertex++) {
+      auto begin = neighbours.begin() + offsets[vertex];
+      auto end = neighbours.begin() + offsets[vertex + 1];
+      std::sort(begin, end);
+      uint64_t previous = vertex;
+      for (auto it = begin; it != end; ++it) {
+        uint64_t gap = *it - previous;
+        PutVarint(bytes_, it == begin ? (gap << 1) ^ (0 - (gap >> 63)) : gap);
+        previous = *it;
+      }
+      offsets_[vertex + 1] = bytes_.size();
+    }
+    bytes_.shrink_to_fit();
+  }
+  Neighbours GetNeighbors(const VType& vertex) const {
+    size_t index = static_cast<size_t>(vertex);
+    return {bytes_.data() + offsets_[index],
+            bytes_.data() + offsets_[index + 1], index};
+  }
+  size_t VertexCount() const { return kVertexCount; }
+  size_t EdgeCount() const { return kEdgeCount; }
+  const std::vector<VType>& Vertices() const { return vertices_; }
+  size_t ByteSize() const {
+    return offsets_.size() * sizeof(uint64_t) + bytes_.size();
+  }
+
+ private:
+  std::vector<uint64_t> offsets_;
+  std::vector<uint8_t> bytes_;
+  const size_t kVertexCount;
+  const size_t kEdgeCount;
+  std::vector<VType> vertices_;
+};
+
+// A binary graph record is a BinaryGraphHeader followed by the CSR arrays
+// offsets[id_bound + 1] and neighbours[arc_count], then weights[arc_count]
+// if kWeighted and, if kEdgeIds, the index of the input edge behind every
+// arc. Every field is a native-endian 64-bit word, so a mapped file is used
+// in place; records may follow each other in one file.
+struct BinaryGraphHeader {
+  static constexpr uint64_t kMagic = 0x3152534348505247;  // "GRPHCSR1"
+  static constexpr uint32_t kUndirected = 1;
+  static constexpr uint32_t kWeighted = 2;
+  static constexpr uint32_t kEdgeIds = 4;
+
+  uint64_t magic = kMagic;
+  uint32_t flags = 0;
+  uint32_t reserved = 0;
+  uint64_t vertex_count = 0;
+  uint64_t id_bound = 0;
+  uint64_t edge_count = 0;
+  uint64_t arc_count = 0;
+  uint64_t source = 0;
+  uint64_t sink = 0;
+};
+
+class BinaryGraph {
+ public:
+  explicit BinaryGraph(std::span<const std::byte> data) {
+    if (data.size() < sizeof(BinaryGraphHeader)) {
+      throw std::runtime_error("truncated graph header");
+    }
+    header_ = reinterpret_cast<const BinaryGraphHeader*>(data.data());
+    if (header_->magic != BinaryGraphHeader::kMagic) {
+      throw std::runtime_error("not a binary graph");
+    }
+    const auto* words = reinterpret_cast<const uint64_t*>(header_ + 1);
+    size_t arcs = header_->arc_count;
+    offsets_ = {words, header_->id_bound + 1};
+    words += offsets_.size();
+    neighbours_ = {words, arcs};
+    words += arcs;
+    if (header_->flags & BinaryGraphHeader::kWeighted) {
+      weights_ = {reinterpret_cast<const int64_t*>(words), arcs};
+      words += arcs;
+    }
+    if (header_->flags & BinaryGraphHeader::kEdgeIds) {
+      edge_ids_ = {words, arcs};
+      words += arcs;
+    }
+    byte_size_ = reinterpret_cast<const std::byte*>(words) - data.data();
+    if (byte_size_ > data.size()) {
+      throw std::runtime_error("truncated graph");
+    }
+  }
+  const BinaryGraphHeader& Header() const { return *header_; }
+  std::span<const uint64_t> Offsets() const { return offsets_; }
+  std::span<const uint64_t> Neighbours() const { return neighbours_; }
+  std::span<const int64_t> Weights() const { return weights_; }
+  std::span<const uint64_t> EdgeIds() const { return edge_ids_; }
+  // The next record, if any, starts this many bytes after the header.
+  size_t ByteSize() const { return byte_size_; }
+
+ private:
+  const BinaryGraphHeader* header_;
+  std::span<const uint64_t> offsets_;
+  std::span<const uint64_t> neighbours_;
+  std::span<const int64_t> weights_;
+  std::span<const uint64_t> edge_ids_;
+  size_t byte_size_;
+};
+
+class MappedFile {
+ public:
+  explicit MappedFile(const char* path) {
+    int descriptor = open(path, O_RDONLY);
+    if (descriptor < 0) {
+      throw std::system_error(errno, std::generic_category(), path);
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0) {
+      int error = errno;
+      close(descriptor);
+      throw std::system_error(error, std::generic_category(), path);
+    }
+    size_ = status.st_size;
+    if (size_ > 0) {
+      data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    }
+    int error = errno;
+    close(descriptor);
+    if (data_ == MAP_FAILED) {
+      throw std::system_error(error, std::generic_category(), path);
+    }
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile() {
+    if (size_ > 0) {
+      munmap(data_, size_);
+    }
+  }
+  std::span<const std::byte> Bytes() const {
+    return {static_cast<const std::byte*>(data_), size_};
+  }
+
+ private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Arcs of a vertex keep the input order of their edges, as CSRListGraph
+// lays them out; weights may be empty unless kWeighted is set.
+void WriteBinaryGraph(std::ostream& output, BinaryGraphHeader header,
+                      const std::vector<std::pair<uint64_t, uint64_t>>& edges,
+                      const std::vector<int64_t>& weights) {
+  bool undirected = header.flags & BinaryGraphHeader::kUndirected;
+  std::vector<uint64_t> offsets(header.id_bound + 1, 0);
+  for (auto edge : edges) {
+    ++offsets[edge.first + 1];
+    if (undirected) {
+      ++offsets[edge.second + 1];
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  header.edge_count = edges.size();
+  header.arc_count = offsets.back();
+  std::vector<uint64_t> neighbours(header.arc_count);
+  std::vector<int64_t> arc_weights(header.arc_count);
+  std::vector<uint64_t> edge_ids(header.arc_count);
+  std::vector<uint64_t> fill(offsets.begin() + 1, offsets.end());
+  auto place = [&](uint64_t from, uint64_t to, size_t index) {
+    size_t arc = --fill[from];
+    neighbours[arc] = to;
+    arc_weights[arc] = weights.empty() ? 0 : weights[index];
+    edge_ids[arc] = index;
+  };
+  for (size_t i = edges.size(); i > 0; i--) {
+    if (undirected) {
+      place(edges[i - 1].second, edges[i - 1].first, i - 1);
+    }
+    place(edges[i - 1].first, edges[i - 1].second, i - 1);
+  }
+  auto write = [&output](const void* data, size_t size) {
+    output.write(static_cast<const char*>(data),
+                 static_cast<std::streamsize>(size));
+  };
+  write(&header, sizeof(header));
+  write(offsets.data(), offsets.size() * sizeof(uint64_t));
+  write(neighbours.data(), neighbours.size() * sizeof(uint64_t));
+  if (header.flags & BinaryGraphHeader::kWeighted) {
+    write(arc_weights.data(), arc_weights.size() * sizeof(int64_t));
+  }
+  if (header.flags & BinaryGraphHeader::kEdgeIds) {
+    write(edge_ids.data(), edge_ids.size() * sizeof(uint64_t));
+  }
+  if (!output) {
+    throw std::runtime_error("failed to write graph");
+  }
+}
+
+// Serves a binary graph record straight from the mapping; vertices are the
+// ids [id_bound - vertex_count, id_bound).
+template <class VType = uint64_t, class EType = std::pair<VType, VType>>
+class MappedCSRGraph {
+  static_assert(sizeof(VType) == sizeof(uint64_t) &&
+                    std::is_unsigned_v<VType>,
+                "records store 64-bit ids");
+
+ public:
+  using VertexType = VType;
+  using EdgeType = EType;
+
+  explicit MappedCSRGraph(const BinaryGraph& graph)
+      : offsets_(graph.Offsets()),
+        neighbours_(reinterpret_cast<const VType*>(graph.Neighbours().data()),
+                    graph.Neighbours().size()),
+        kVertexCount(graph.Header().vertex_count),
+        kEdgeCount(graph.Header().edge_count) {}
+  std::span<const VType> GetNeighbors(const VType& vertex) const {
+    return neighbours_.subspan(offsets_[vertex],
+                               offsets_[vertex + 1] - offsets_[vertex]);
+  }
+  size_t VertexCount() const { return kVertexCount; }
+  size_t EdgeCount() const { return kEdgeCount; }
+  auto Vertices() const {
+    VType id_bound = offsets_.size() - 1;
+    return std::views::iota(id_bound - kVertexCount, id_bound);
+  }
+
+ private:
+  std::span<const uint64_t> offsets_;
+  std::span<const VType> neighbours_;
+  const size_t kVertexCount;
+  const size_t kEdgeCount;
+};
+
 template <class VType, class EType>
 class Visitor {
  public:
   virtual void Visit(const EType&) = 0;
+  // discovered holds the indices in neighbours of the vertices that were
+  // reached from source for the first time.
+  virtual void VisitBatch(const VType& source,
+                          std::span<const VType> neighbours,
+                          std::span<const uint32_t> discovered) {
+    for (uint32_t index : discovered) {
+      Visit({source, neighbours[index]});
+    }
+  }
   ~Visitor() = default;
 };
 
 template <class VType, class EType = std::pair<VType, VType>>
-class BFSVisitor : public Visitor<VType, EType> {
+class BFSVisitor final : public Visitor<VType, EType> {
  public:
   void Visit(const EType& edge) override {
     if (map_.find(edge.second) == map_.end()) {
       map_[edge.second] = edge.first;
     }
   };
+  void VisitBatch(const VType& source, std::span<const VType> neighbours,
+                  std::span<const uint32_t> discovered) override {
+    for (uint32_t index : discovered) {
+      map_.try_emplace(neighbours[index], source);
+    }
+  }
   std::unordered_map<VType, VType> GetMap() { return map_; }
   ~BFSVisitor() = default;
 
@@ -74,60 +675,869 @@ class BFSVisitor : public Visitor<VType, EType> {
   std::unordered_map<VType, VType> map_;
 };
 
-template <class VType, class EType>
-void BFS(Graph<VType>& graph, VType start, Visitor<VType, EType>& visitor) {
-  std::unordered_map<VType, bool> visited;
+// Visit may be called from several threads at once, but at most once per
+// discovered vertex, so every slot below has a single writer.
+template <class VType, class EType = std::pair<VType, VType>>
+class ParallelBFSVisitor final : public Visitor<VType, EType> {
+ public:
+  void Visit(const EType& edge) override {
+    parents_[edge.second] = edge.first;
+    reached_[edge.second] = 1;
+  };
+  void VisitBatch(const VType& source, std::span<const VType> neighbours,
+                  std::span<const uint32_t> discovered) override {
+    for (uint32_t index : discovered) {
+      parents_[neighbours[index]] = source;
+      reached_[neighbours[index]] = 1;
+    }
+  }
+  std::unordered_map<VType, VType> GetMap() {
+    std::unordered_map<VType, VType> map;
+    for (size_t i = 0; i < parents_.size(); i++) {
+      if (reached_[i] != 0) {
+        map[static_cast<VType>(i)] = parents_[i];
+      }
+    }
+    return map;
+  }
+  ParallelBFSVisitor(size_t id_bound)
+      : parents_(id_bound), reached_(id_bound, 0) {}
+  ~ParallelBFSVisitor() = default;
+
+ private:
+  std::vector<VType> parents_;
+  std::vector<uint8_t> reached_;
+};
+
+template <class GraphType>
+concept NeighbourGraph =
+    requires(GraphType& graph, const typename GraphType::VertexType& vertex) {
+      { graph.GetNeighbors(vertex) } -> std::ranges::range;
+      { graph.Vertices() } -> std::ranges::range;
+    };
+
+template <class VisitorType, class EType>
+concept EdgeVisitor = requires(VisitorType& visitor, const EType& edge) {
+  visitor.Visit(edge);
+};
+
+template <class VisitorType, class VType>
+concept BatchEdgeVisitor = requires(VisitorType& visitor, const VType& source,
+                                    std::span<const VType> neighbours,
+                                    std::span<const uint32_t> discovered) {
+  visitor.VisitBatch(source, neighbours, discovered);
+};
+
+template <class VisitorType, class VType>
+void VisitDiscovered(VisitorType& visitor, const VType& source,
+                     std::span<const VType> neighbours,
+                     std::span<const uint32_t> discovered) {
+  if constexpr (BatchEdgeVisitor<VisitorType, VType>) {
+    visitor.VisitBatch(source, neighbours, discovered);
+  } else {
+    for (uint32_t index : discovered) {
+      visitor.Visit({source, neighbours[index]});
+    }
+  }
+}
+
+template <class GraphType>
+size_t IdBound(GraphType& graph) {
+  size_t id_bound = 0;
+  for (auto vertex : graph.Vertices()) {
+    id_bound = std::max(id_bound, static_cast<size_t>(vertex) + 1);
+  }
+  return id_bound;
+}
+
+class EpochVisited {
+ public:
+  explicit EpochVisited(size_t size) : stamps_(size, 0) {}
+  bool Test(size_t index) const { return stamps_[index] == epoch_; }
+  void Set(size_t index) { stamps_[index] = epoch_; }
+  void Reset() {
+    if (++epoch_ == 0) {
+      std::fill(stamps_.begin(), stamps_.end(), 0);
+      epoch_ = 1;
+    }
+  }
+
+ private:
+  std::vector<uint32_t> stamps_;
+  uint32_t epoch_ = 1;
+};
+
+template <NeighbourGraph GraphType, class VisitorType, class VType>
+  requires EdgeVisitor<VisitorType, typename GraphType::EdgeType>
+void BFS(GraphType& graph, VType start, VisitorType& visitor,
+         EpochVisited& visited) {
+  visited.Reset();
   std::queue<VType> queue;
+  std::vector<uint32_t> discovered;
+  visited.Set(start);
   queue.push(start);
   while (!queue.empty()) {
     VType current = queue.front();
-    for (VType vertex : graph.GetNeighbors(current)) {
-      if (!visited[vertex]) {
-        visitor.Visit({current, vertex});
-        queue.push(vertex);
+    std::span<const VType> neighbours = graph.GetNeighbors(current);
+    discovered.clear();
+    for (uint32_t i = 0; i < neighbours.size(); i++) {
+      if (!visited.Test(neighbours[i])) {
+        visited.Set(neighbours[i]);
+        discovered.push_back(i);
+        queue.push(neighbours[i]);
       }
     }
-    visited[current] = true;
+    VisitDiscovered(visitor, current, neighbours, discovered);
     queue.pop();
   }
 }
 
-int main() {
+template <NeighbourGraph GraphType, class VisitorType, class VType>
+  requires EdgeVisitor<VisitorType, typename GraphType::EdgeType>
+void BFS(GraphType& graph, VType start, VisitorType& visitor) {
+  EpochVisited visited(
+      std::max(IdBound(graph), static_cast<size_t>(start) + 1));
+  BFS(graph, start, visitor, visited);
+}
+
+template <NeighbourGraph GraphType, class VisitorType, class VType>
+  requires EdgeVisitor<VisitorType, typename GraphType::EdgeType>
+void DirectionOptimizingBFS(GraphType& graph, VType start,
+                            VisitorType& visitor) {
+  static constexpr size_t kUnvisited = std::numeric_limits<size_t>::max();
+  static constexpr size_t kAlpha = 14;
+  static constexpr size_t kBeta = 24;
+  size_t id_bound = static_cast<size_t>(start) + 1;
+  size_t unexplored_edges = 0;
+  for (VType vertex : graph.Vertices()) {
+    id_bound = std::max(id_bound, static_cast<size_t>(vertex) + 1);
+    unexplored_edges += graph.GetNeighbors(vertex).size();
+  }
+  std::vector<size_t> rank(id_bound, kUnvisited);
+  std::vector<VType> parent(id_bound);
+  std::vector<uint64_t> bits((id_bound + 63) / 64, 0);
+  auto test = [&bits](VType vertex) {
+    return ((bits[vertex / 64] >> (vertex % 64)) & 1) != 0;
+  };
+  auto flip = [&bits](VType vertex) {
+    bits[vertex / 64] ^= uint64_t{1} << (vertex % 64);
+  };
+  size_t order = 0;
+  rank[start] = order++;
+  std::vector<VType> frontier = {start};
+  std::vector<VType> next;
+  std::vector<uint32_t> discovered;
+  bool bottom_up = false;
+  while (!frontier.empty()) {
+    size_t frontier_edges = 0;
+    for (VType vertex : frontier) {
+      frontier_edges += graph.GetNeighbors(vertex).size();
+    }
+    unexplored_edges -= std::min(unexplored_edges, frontier_edges);
+    if (!bottom_up) {
+      bottom_up = frontier_edges > unexplored_edges / kAlpha;
+    } else {
+      bottom_up = frontier.size() * kBeta >= graph.VertexCount();
+    }
+    next.clear();
+    if (!bottom_up) {
+      for (VType current : frontier) {
+        std::span<const VType> neighbours = graph.GetNeighbors(current);
+        discovered.clear();
+        for (uint32_t i = 0; i < neighbours.size(); i++) {
+          if (rank[neighbours[i]] == kUnvisited) {
+            rank[neighbours[i]] = order++;
+            discovered.push_back(i);
+            next.push_back(neighbours[i]);
+          }
+        }
+        VisitDiscovered(visitor, current, neighbours, discovered);
+      }
+      std::swap(frontier, next);
+      continue;
+    }
+    // Every unvisited vertex looks for the frontier neighbour the queue
+    // would have reached first, so the parents match the top-down order.
+    for (VType vertex : frontier) {
+      flip(vertex);
+    }
+    for (VType vertex : graph.Vertices()) {
+      if (rank[vertex] != kUnvisited) {
+        continue;
+      }
+      size_t best = kUnvisited;
+      for (VType neighbour : graph.GetNeighbors(vertex)) {
+        if (test(neighbour) && rank[neighbour] < best) {
+          best = rank[neighbour];
+          parent[vertex] = neighbour;
+          if (best == rank[frontier.front()]) {
+            break;
+          }
+        }
+      }
+      if (best != kUnvisited) {
+        next.push_back(vertex);
+      }
+    }
+    for (VType vertex : frontier) {
+      flip(vertex);
+    }
+    for (VType vertex : next) {
+      flip(vertex);
+    }
+    std::stable_sort(next.begin(), next.end(), [&](VType lhs, VType rhs) {
+      return rank[parent[lhs]] < rank[parent[rhs]];
+    });
+    frontier.clear();
+    for (size_t begin = 0, end = 0; begin < next.size(); begin = end) {
+      VType current = parent[next[begin]];
+      while (end < next.size() && parent[next[end]] == current) {
+        ++end;
+      }
+      for (VType vertex : graph.GetNeighbors(current)) {
+        if (test(vertex) && parent[vertex] == current) {
+          flip(vertex);
+          rank[vertex] = order++;
+          visitor.Visit({current, vertex});
+          frontier.push_back(vertex);
+          if (frontier.size() == end) {
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
+template <NeighbourGraph GraphType, class VisitorType, class VType>
+  requires EdgeVisitor<VisitorType, typename GraphType::EdgeType>
+void ParallelBFS(GraphType& graph, VType start, VisitorType& visitor,
+                 size_t thread_count = std::thread::hardware_concurrency()) {
+  static constexpr size_t kChunk = 64;
+  thread_count = std::max<size_t>(thread_count, 1);
+  size_t id_bound = static_cast<size_t>(start) + 1;
+  for (VType vertex : graph.Vertices()) {
+    id_bound = std::max(id_bound, static_cast<size_t>(vertex) + 1);
+  }
+  std::vector<std::atomic<uint64_t>> visited((id_bound + 63) / 64);
+  auto claim = [&visited](VType vertex) {
+    uint64_t mask = uint64_t{1} << (vertex % 64);
+    return (visited[vertex / 64].fetch_or(mask, std::memory_order_relaxed) &
+            mask) == 0;
+  };
+  claim(start);
+  std::vector<VType> frontier = {start};
+  std::vector<std::vector<VType>> buffers(thread_count);
+  std::atomic<size_t> cursor = 0;
+  bool finished = false;
+  auto next_level = [&]() noexcept {
+    frontier.clear();
+    for (auto& buffer : buffers) {
+      frontier.insert(frontier.end(), buffer.begin(), buffer.end());
+      buffer.clear();
+    }
+    cursor.store(0, std::memory_order_relaxed);
+    finished = frontier.empty();
+  };
+  std::barrier sync(static_cast<std::ptrdiff_t>(thread_count), next_level);
+  auto worker = [&](size_t id) {
+    std::vector<uint32_t> discovered;
+    while (!finished) {
+      std::vector<VType>& local = buffers[id];
+      for (size_t begin = cursor.fetch_add(kChunk); begin < frontier.size();
+           begin = cursor.fetch_add(kChunk)) {
+        size_t end = std::min(begin + kChunk, frontier.size());
+        for (size_t i = begin; i < end; i++) {
+          VType current = frontier[i];
+          std::span<const VType> neighbours = graph.GetNeighbors(current);
+          discovered.clear();
+          for (uint32_t j = 0; j < neighbours.size(); j++) {
+            if (claim(neighbours[j])) {
+              discovered.push_back(j);
+              local.push_back(neighbours[j]);
+            }
+          }
+          VisitDiscovered(visitor, current, neighbours, discovered);
+        }
+      }
+      sync.arrive_and_wait();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t id = 1; id < thread_count; id++) {
+    threads.emplace_back(worker, id);
+  }
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Runs one BFS per source, 64 sources per pass: bit i of the per-vertex
+// words belongs to sources[batch + i], so a single scan of an adjacency list
+// advances every traversal that reached the vertex.
+// discover(source_index, parent, vertex, distance) is called once per source
+// and reached vertex other than the source itself.
+template <NeighbourGraph GraphType, class VType, class Callback>
+void MultiSourceBFS(GraphType& graph, std::span<const VType> sources,
+                    Callback&& discover) {
+  static constexpr size_t kWidth = 64;
+  size_t id_bound = IdBound(graph);
+  for (VType source : sources) {
+    id_bound = std::max(id_bound, static_cast<size_t>(source) + 1);
+  }
+  std::vector<uint64_t> seen(id_bound);
+  std::vector<uint64_t> visit(id_bound);
+  std::vector<uint64_t> next(id_bound);
+  std::vector<VType> frontier;
+  std::vector<VType> next_frontier;
+  for (size_t batch = 0; batch < sources.size(); batch += kWidth) {
+    size_t count = std::min(kWidth, sources.size() - batch);
+    std::fill(seen.begin(), seen.end(), 0);
+    frontier.clear();
+    for (size_t i = 0; i < count; i++) {
+      VType source = sources[batch + i];
+      if (visit[source] == 0) {
+        frontier.push_back(source);
+      }
+      seen[source] |= uint64_t{1} << i;
+      visit[source] |= uint64_t{1} << i;
+    }
+    for (size_t distance = 1; !frontier.empty(); distance++) {
+      next_frontier.clear();
+      for (VType current : frontier) {
+        uint64_t active = visit[current];
+        for (VType vertex : graph.GetNeighbors(current)) {
+          uint64_t fresh = active & ~seen[vertex];
+          if (fresh == 0) {
+            continue;
+          }
+          if (next[vertex] == 0) {
+            next_frontier.push_back(vertex);
+          }
+          next[vertex] |= fresh;
+          seen[vertex] |= fresh;
+          for (; fresh != 0; fresh &= fresh - 1) {
+            discover(batch + std::countr_zero(fresh), current, vertex,
+                     distance);
+          }
+        }
+      }
+      for (VType vertex : frontier) {
+        visit[vertex] = 0;
+      }
+      for (VType vertex : next_frontier) {
+        visit[vertex] = next[vertex];
+        next[vertex] = 0;
+      }
+      std::swap(frontier, next_frontier);
+    }
+  }
+}
+
+template <NeighbourGraph GraphType, class VType>
+std::vector<std::vector<size_t>> MultiSourceDistances(
+    GraphType& graph, std::span<const VType> sources) {
+  static constexpr size_t kUnreachable = std::numeric_limits<size_t>::max();
+  size_t id_bound = IdBound(graph);
+  for (VType source : sources) {
+    id_bound = std::max(id_bound, static_cast<size_t>(source) + 1);
+  }
+  std::vector<std::vector<size_t>> distances(
+      sources.size(), std::vector<size_t>(id_bound, kUnreachable));
+  for (size_t i = 0; i < sources.size(); i++) {
+    distances[i][sources[i]] = 0;
+  }
+  MultiSourceBFS(graph, sources,
+                 [&distances](size_t index, const VType& parent,
+                              const VType& vertex, size_t distance) {
+                   distances[index][vertex] = distance;
+                 });
+  return distances;
+}
+
+// visitors[i] receives the tree edges of the traversal from sources[i].
+template <NeighbourGraph GraphType, class VisitorType, class VType>
+  requires EdgeVisitor<VisitorType, typename GraphType::EdgeType>
+void MultiSourceParents(GraphType& graph, std::span<const VType> sources,
+                        std::span<VisitorType> visitors) {
+  MultiSourceBFS(graph, sources,
+                 [&visitors](size_t index, const VType& parent,
+                             const VType& vertex, size_t distance) {
+                   visitors[index].Visit({parent, vertex});
+                 });
+}
+
+// reverse must list the in-neighbours of every vertex; for undirected graphs
+// it is the graph itself. Returns the vertices of a shortest start-end path,
+// or an empty vector if end is unreachable.
+template <NeighbourGraph GraphType, NeighbourGraph ReverseGraphType,
+          class VType>
+std::vector<VType> BidirectionalBFS(GraphType& graph, ReverseGraphType& reverse,
+                                    VType start, VType end) {
+  static constexpr size_t kUnvisited = std::numeric_limits<size_t>::max();
+  if (start == end) {
+    return {start};
+  }
+  size_t id_bound = std::max({IdBound(graph), IdBound(reverse),
+                              static_cast<size_t>(start) + 1,
+                              static_cast<size_t>(end) + 1});
+  std::vector<size_t> distance[2] = {std::vector<size_t>(id_bound, kUnvisited),
+                                     std::vector<size_t>(id_bound, kUnvisited)};
+  std::vector<VType> parent[2] = {std::vector<VType>(id_bound),
+                                  std::vector<VType>(id_bound)};
+  std::vector<VType> frontier[2] = {{start}, {end}};
+  distance[0][start] = 0;
+  distance[1][end] = 0;
+  std::vector<VType> next;
+  size_t best = kUnvisited;
+  VType meet_from = start;
+  VType meet_to = end;
+  auto expand = [&](auto& direction, size_t side) {
+    next.clear();
+    for (VType current : frontier[side]) {
+      for (VType vertex : direction.GetNeighbors(current)) {
+        if (distance[1 - side][vertex] != kUnvisited) {
+          size_t length =
+              distance[side][current] + 1 + distance[1 - side][vertex];
+          if (length < best) {
+            best = length;
+            meet_from = side == 0 ? current : vertex;
+            meet_to = side == 0 ? vertex : current;
+          }
+        }
+        if (distance[side][vertex] == kUnvisited) {
+          distance[side][vertex] = distance[side][current] + 1;
+          parent[side][vertex] = current;
+          next.push_back(vertex);
+        }
+      }
+    }
+    std::swap(frontier[side], next);
+  };
+  while (best == kUnvisited && !frontier[0].empty() && !frontier[1].empty()) {
+    if (frontier[0].size() <= frontier[1].size()) {
+      expand(graph, 0);
+    } else {
+      expand(reverse, 1);
+    }
+  }
+  std::vector<VType> path;
+  if (best == kUnvisited) {
+    return path;
+  }
+  for (VType vertex = meet_from; vertex != start;
+       vertex = parent[0][vertex]) {
+    path.push_back(vertex);
+  }
+  path.push_back(start);
+  std::reverse(path.begin(), path.end());
+  for (VType vertex = meet_to; vertex != end; vertex = parent[1][vertex]) {
+    path.push_back(vertex);
+  }
+  path.push_back(end);
+  return path;
+}
+
+template <NeighbourGraph GraphType, class VType>
+std::vector<VType> BidirectionalBFS(GraphType& graph, VType start, VType end) {
+  return BidirectionalBFS(graph, graph, start, end);
+}
+
+// Reverse Cuthill-McKee: every component is walked breadth first from a
+// vertex of least degree with neighbours taken by increasing degree, and the
+// walk is reversed. Returns the new id of every id below IdBound(graph); the
+// new ids are the old vertex ids, permuted.
+template <NeighbourGraph GraphType>
+std::vector<typename GraphType::VertexType> ReverseCuthillMcKee(
+    GraphType& graph) {
+  using VType = typename GraphType::VertexType;
+  size_t id_bound = IdBound(graph);
+  std::vector<size_t> degree(id_bound, 0);
+  std::vector<VType> labels;
+  for (VType vertex : graph.Vertices()) {
+    degree[vertex] = graph.GetNeighbors(vertex).size();
+    labels.push_back(vertex);
+  }
+  auto by_degree = [&degree](VType first, VType second) {
+    return degree[first] < degree[second];
+  };
+  std::vector<VType> roots(labels);
+  std::stable_sort(roots.begin(), roots.end(), by_degree);
+  std::vector<VType> order;
+  order.reserve(labels.size());
+  std::vector<bool> placed(id_bound, false);
+  for (VType root : roots) {
+    if (placed[root]) {
+      continue;
+    }
+    placed[root] = true;
+    order.push_back(root);
+    for (size_t head = order.size() - 1; head < order.size(); head++) {
+      size_t begin = order.size();
+      for (VType neighbour : graph.GetNeighbors(order[head])) {
+        if (!placed[neighbour]) {
+          placed[neighbour] = true;
+          order.push_back(neighbour);
+        }
+      }
+      std::stable_sort(order.begin() + begin, order.end(), by_degree);
+    }
+  }
+  std::sort(labels.begin(), labels.end());
+  std::vector<VType> new_ids(id_bound);
+  std::iota(new_ids.begin(), new_ids.end(), 0);
+  for (size_t i = 0; i < order.size(); i++) {
+    new_ids[order[order.size() - 1 - i]] = labels[i];
+  }
+  return new_ids;
+}
+
+// Answers on a CSR copy relabeled by ReverseCuthillMcKee. Adjacency lists
+// keep their order, so the search makes the same choices and the path maps
+// back to the one the original graph gives.
+template <class VType>
+std::vector<VType> ReorderedBidirectionalBFS(
+    const std::vector<VType>& vertices,
+    std::vector<std::pair<VType, VType>> edges, VType start, VType end) {
+  std::vector<VType> new_ids;
+  {
+    CSRListGraph<VType> graph(vertices, edges);
+    new_ids = ReverseCuthillMcKee(graph);
+  }
+  std::vector<VType> old_ids(new_ids.size());
+  for (size_t vertex = 0; vertex < new_ids.size(); vertex++) {
+    old_ids[new_ids[vertex]] = vertex;
+  }
+  for (auto& edge : edges) {
+    edge = {new_ids[edge.first], new_ids[edge.second]};
+  }
+  CSRListGraph<VType> graph(vertices, edges);
+  std::vector<VType> path =
+      BidirectionalBFS(graph, new_ids[start], new_ids[end]);
+  for (VType& vertex : path) {
+    vertex = old_ids[vertex];
+  }
+  return path;
+}
+
+// Counts the hardware cache misses of the calling thread between Start and
+// Stop through perf_event_open; Misses() is -1 where the kernel or the
+// machine does not expose the counter.
+class CacheMissCounter {
+ public:
+  CacheMissCounter() {
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    descriptor_ = static_cast<int>(
+        syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+  }
+  CacheMissCounter(const CacheMissCounter&) = delete;
+  CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+  ~CacheMissCounter() {
+    if (descriptor_ >= 0) {
+      close(descriptor_);
+    }
+  }
+  void Start() {
+    if (descriptor_ >= 0) {
+      ioctl(descriptor_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(descriptor_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+  void Stop() {
+    if (descriptor_ >= 0) {
+      ioctl(descriptor_, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  int64_t Misses() const {
+    uint64_t count = 0;
+    if (descriptor_ < 0 ||
+        read(descriptor_, &count, sizeof(count)) != sizeof(count)) {
+      return -1;
+    }
+    return static_cast<int64_t>(count);
+  }
+
+ private:
+  int descriptor_;
+};
+
+// Runs kernel once and prints its wall time and cache misses as one JSON
+// object per line.
+template <class Kernel>
+void ReportKernel(std::string_view name, std::string_view order,
+                  Kernel&& kernel, FastOutput& output) {
+  CacheMissCounter counter;
+  auto begin = std::chrono::steady_clock::now();
+  counter.Start();
+  kernel();
+  counter.Stop();
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  output << "{\"kernel\": \"" << name << "\", \"order\": \"" << order
+         << "\", \"microseconds\": "
+         << std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+                .count()
+         << ", \"cache_misses\": " << counter.Misses() << "}\n";
+}
+
+// Prints the bytes an adjacency layout takes as one JSON object per line.
+void ReportBytes(std::string_view layout, size_t bytes, FastOutput& output) {
+  output << "{\"layout\": \"" << layout << "\", \"bytes\": " << bytes
+         << "}\n";
+}
+
+// Runs kernel once on a synthetic input and prints its throughput as one
+// JSON object per line; count is the number of units the kernel processed.
+template <class Kernel>
+void ReportThroughput(std::string_view name, std::string_view generator,
+                      size_t size, std::string_view unit, size_t count,
+                      Kernel&& kernel, FastOutput& output) {
+  auto begin = std::chrono::steady_clock::now();
+  kernel();
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  uint64_t microseconds = std::max<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(),
+      1);
+  output << "{\"kernel\": \"" << name << "\", \"generator\": \"" << generator
+         << "\", \"size\": " << size << ", \"" << unit << "\": " << count
+         << ", \"microseconds\": " << microseconds << ", \"" << unit
+         << "_per_second\": " << count * 1000000 / microseconds << "}\n";
+}
+
+// Deterministic synthetic graphs for the benchmarks: the same generator,
+// vertex count and seed always give the same edges over [0, vertex_count).
+// "rmat" is a power-law R-MAT graph and "geometric" joins random points of
+// the unit square that are close enough for about eight neighbours each;
+// "grid" is the largest square 4-neighbour grid that fits and "path" one
+// long path.
+std::vector<std::pair<size_t, size_t>> SyntheticEdges(
+    std::string_view generator, size_t vertex_count, uint64_t seed = 1) {
+  static constexpr size_t kDegree = 8;
+  std::mt19937_64 random(seed);
+  auto unit = [&random]() {
+    return static_cast<double>(random() >> 11) * 0x1p-53;
+  };
+  std::vector<std::pair<size_t, size_t>> edges;
+  if (generator == "rmat") {
+    size_t scale = std::bit_width(std::max<size_t>(vertex_count, 2) - 1);
+    edges.reserve(vertex_count * kDegree / 2);
+    while (edges.size() < vertex_count * kDegree / 2) {
+      size_t from = 0;
+      size_t to = 0;
+      for (size_t bit = 0; bit < scale; bit++) {
+        double quadrant = unit();
+        from = 2 * from + (quadrant >= 0.76);
+        to = 2 * to + ((quadrant >= 0.57 && quadrant < 0.76) ||
+                       quadrant >= 0.95);
+      }
+      if (from < vertex_count && to < vertex_count) {
+        edges.emplace_back(from, to);
+      }
+    }
+  } else if (generator == "grid") {
+    size_t side = static_cast<size_t>(std::sqrt(vertex_count));
+    while (side * side > vertex_count) {
+      side--;
+    }
+    while ((side + 1) * (side + 1) <= vertex_count) {
+      side++;
+    }
+    for (size_t row = 0; row < side; row++) {
+      for (size_t column = 0; column < side; column++) {
+        size_t vertex = row * side + column;
+        if (column + 1 < side) {
+          edges.emplace_back(vertex, vertex + 1);
+        }
+        if (row + 1 < side) {
+          edges.emplace_back(vertex, vertex + side);
+        }
+      }
+    }
+  } else if (generator == "geometric") {
+    double radius = std::sqrt(kDegree / (std::numbers::pi * vertex_count));
+    size_t cells = std::max<size_t>(1, static_cast<size_t>(1 / radius));
+    std::vector<std::pair<double, double>> points(vertex_count);
+    std::vector<size_t> offsets(cells * cells + 1, 0);
+    auto cell_of = [cells](double coordinate) {
+      return std::min(cells - 1, static_cast<size_t>(coordinate * cells));
+    };
+    for (auto& point : points) {
+      point = {unit(), unit()};
+      ++offsets[cell_of(point.first) * cells + cell_of(point.second) + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<size_t> members(vertex_count);
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < vertex_count; i++) {
+      members[fill[cell_of(points[i].first) * cells +
+                   cell_of(points[i].second)]++] = i;
+    }
+    for (size_t i = 0; i < vertex_count; i++) {
+      size_t row = cell_of(points[i].first);
+      size_t column = cell_of(points[i].second);
+      for (size_t x = row - (row > 0); x <= std::min(row + 1, cells - 1);
+           x++) {
+        for (size_t y = column - (column > 0);
+             y <= std::min(column + 1, cells - 1); y++) {
+          for (size_t k = offsets[x * cells + y];
+               k < offsets[x * cells + y + 1]; k++) {
+            size_t j = members[k];
+            double dx = points[i].first - points[j].first;
+            double dy = points[i].second - points[j].second;
+            if (j > i && dx * dx + dy * dy < radius * radius) {
+              edges.emplace_back(i, j);
+            }
+          }
+        }
+      }
+    }
+  } else if (generator == "path") {
+    for (size_t i = 1; i < vertex_count; i++) {
+      edges.emplace_back(i - 1, i);
+    }
+  } else {
+    throw std::invalid_argument("unknown generator " +
+                                std::string(generator));
+  }
+  return edges;
+}
+
+template <class VType, class Search>
+void PrintPath(VType start, VType end, Search&& search, FastOutput& output) {
+  if (start == end) {
+    output << 0 << '\n' << start;
+    return;
+  }
+  std::vector<VType> result = search(start, end);
+  if (result.empty()) {
+    output << -1;
+    return;
+  }
+  output << result.size() - 1 << '\n';
+  for (VType vertex : result) {
+    output << vertex << ' ';
+  }
+}
+
+template <class VType>
+void BenchSynthetic(std::string_view name, std::string_view generator,
+                    size_t vertex_count,
+                    const std::vector<std::pair<size_t, size_t>>& edges,
+                    FastOutput& output) {
+  std::vector<VType> vertices(vertex_count);
+  std::iota(vertices.begin(), vertices.end(), VType{0});
+  std::vector<std::pair<VType, VType>> arcs(edges.begin(), edges.end());
+  CSRListGraph<VType> graph(vertices, arcs);
+  ParallelBFSVisitor<VType> visitor(vertex_count);
+  ReportThroughput(
+      name, generator, vertex_count, "edges", edges.size(),
+      [&]() { BFS(graph, VType{0}, visitor); }, output);
+}
+
+// With no arguments the task reads text from stdin; "--convert file" writes
+// that input as a binary graph record and "file" answers from such a record.
+// "--bench" times the search on the input order, on the compressed lists and
+// on the RCM order; "--bench generator size" times BFS on a synthetic graph
+// with 64-bit and with 32-bit vertex ids.
+int main(int argc, char** argv) {
+  FastOutput output;
+  if (argc == 4 && std::string_view(argv[1]) == "--bench") {
+    size_t vertex_count = std::stoull(argv[3]);
+    std::vector<std::pair<size_t, size_t>> edges =
+        SyntheticEdges(argv[2], vertex_count);
+    BenchSynthetic<uint64_t>("bfs_uint64", argv[2], vertex_count, edges,
+                             output);
+    if (vertex_count <= std::numeric_limits<uint32_t>::max()) {
+      BenchSynthetic<uint32_t>("bfs_uint32", argv[2], vertex_count, edges,
+                               output);
+    }
+    return 0;
+  }
+  if (argc == 2 && std::string_view(argv[1]) != "--bench") {
+    MappedFile file(argv[1]);
+    BinaryGraph record(file.Bytes());
+    MappedCSRGraph<size_t> graph(record);
+    PrintPath(
+        record.Header().source, record.Header().sink,
+        [&graph](size_t from, size_t to) {
+          return BidirectionalBFS(graph, from, to);
+        },
+        output);
+    return 0;
+  }
+  FastInput input;
   size_t vertex_count;
   size_t edge_count;
-  std::cin >> vertex_count >> edge_count;
+  input >> vertex_count >> edge_count;
   size_t start;
   size_t end;
-  std::cin >> start >> end;
-  if (start == end) {
-    std::cout << 0 << '\n' << start;
-    return 0;
-  }
+  input >> start >> end;
   std::vector<size_t> vertices(vertex_count);
   std::iota(vertices.begin(), vertices.end(), 1);
   std::vector<std::pair<size_t, size_t>> edges;
   for (size_t i = 0; i < edge_count; i++) {
     size_t first;
     size_t second;
-    std::cin >> first >> second;
+    input >> first >> second;
     edges.emplace_back(first, second);
   }
-  ListGraph<size_t> graph(vertices, edges);
-  BFSVisitor<size_t> visitor;
-  BFS(graph, start, visitor);
-  auto map = visitor.GetMap();
-  std::vector<size_t> result;
-  if (map.find(end) == map.end()) {
-    std::cout << -1;
+  if (argc == 3 && std::string_view(argv[1]) == "--convert") {
+    BinaryGraphHeader header;
+    header.flags = BinaryGraphHeader::kUndirected;
+    header.vertex_count = vertex_count;
+    header.id_bound = vertex_count + 1;
+    header.source = start;
+    header.sink = end;
+    std::ofstream binary(argv[2], std::ios::binary);
+    WriteBinaryGraph(
+        binary, header,
+        std::vector<std::pair<uint64_t, uint64_t>>(edges.begin(), edges.end()),
+        {});
     return 0;
   }
-  while (map.find(end) != map.end()) {
-    result.push_back(end);
-    end = map[end];
-  }
-  result.push_back(end);
-  std::cout << result.size() - 1 << std::endl;
-  for (size_t i = 1; i <= result.size(); i++) {
-    std::cout << result[result.size() - i] << ' ';
+  if (argc == 2 && std::string_view(argv[1]) == "--bench") {
+    CSRListGraph<size_t> graph(vertices, edges);
+    BidirectionalBFS(graph, start, end);
+    ReportKernel(
+        "bidirectional_bfs", "input",
+        [&]() { BidirectionalBFS(graph, start, end); }, output);
+    CompressedCSRGraph<size_t> compressed(vertices, edges);
+    ReportBytes("csr", graph.ByteSize(), output);
+    ReportBytes("compressed", compressed.ByteSize(), output);
+    BidirectionalBFS(compressed, start, end);
+    ReportKernel(
+        "bidirectional_bfs", "compressed",
+        [&]() { BidirectionalBFS(compressed, start, end); }, output);
+    std::vector<size_t> new_ids;
+    ReportKernel(
+        "relabel", "rcm",
+        [&]() {
+          new_ids = ReverseCuthillMcKee(graph);
+          for (auto& edge : edges) {
+            edge = {new_ids[edge.first], new_ids[edge.second]};
+          }
+        },
+        output);
+    CSRListGraph<size_t> reordered(vertices, edges);
+    BidirectionalBFS(reordered, new_ids[start], new_ids[end]);
+    ReportKernel(
+        "bidirectional_bfs", "rcm",
+        [&]() { BidirectionalBFS(reordered, new_ids[start], new_ids[end]); },
+        output);
+    return 0;
   }
-}
\ No newline at end of file
+  CSRListGraph<size_t> graph(vertices, edges);
+  PrintPath(
+      start, end,
+      [&graph](size_t from, size_t to) {
+        return BidirectionalBFS(graph, from, to);
+      },
+      output);
+  return 0;
+}
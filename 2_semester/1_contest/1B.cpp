@@ -1,10 +1,171 @@
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 #include <algorithm>
-#include <iostream>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
 #include <queue>
 #include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
 std::vector<int> Dijkstra(
     std::vector<std::vector<std::pair<size_t, int>>>& edges,
     size_t vertex_count, size_t start) {
@@ -30,16 +191,152 @@ std::vector<int> Dijkstra(
   return results;
 }
 
-int main() {
-  std::ios_base::sync_with_stdio(false);
-  std::cin.tie(nullptr);
-  std::cout.tie(nullptr);
+// Reverse Cuthill-McKee over the arcs of an adjacency: every component is
+// walked breadth first from a vertex of least degree with neighbours taken
+// by increasing degree, and the walk is reversed. Returns the new id of
+// every vertex.
+std::vector<size_t> ReverseCuthillMcKee(
+    const std::vector<std::vector<std::pair<size_t, int>>>& edges) {
+  size_t vertex_count = edges.size();
+  auto by_degree = [&edges](size_t first, size_t second) {
+    return edges[first].size() < edges[second].size();
+  };
+  std::vector<size_t> roots(vertex_count);
+  std::iota(roots.begin(), roots.end(), 0);
+  std::stable_sort(roots.begin(), roots.end(), by_degree);
+  std::vector<size_t> order;
+  order.reserve(vertex_count);
+  std::vector<bool> placed(vertex_count, false);
+  for (size_t root : roots) {
+    if (placed[root]) {
+      continue;
+    }
+    placed[root] = true;
+    order.push_back(root);
+    for (size_t head = order.size() - 1; head < order.size(); head++) {
+      size_t begin = order.size();
+      for (auto edge : edges[order[head]]) {
+        if (!placed[edge.first]) {
+          placed[edge.first] = true;
+          order.push_back(edge.first);
+        }
+      }
+      std::stable_sort(order.begin() + begin, order.end(), by_degree);
+    }
+  }
+  std::vector<size_t> new_ids(vertex_count);
+  for (size_t i = 0; i < vertex_count; i++) {
+    new_ids[order[vertex_count - 1 - i]] = i;
+  }
+  return new_ids;
+}
+
+// Moves every vertex to its new id; adjacency lists keep their order.
+std::vector<std::vector<std::pair<size_t, int>>> Relabel(
+    const std::vector<std::vector<std::pair<size_t, int>>>& edges,
+    const std::vector<size_t>& new_ids) {
+  std::vector<std::vector<std::pair<size_t, int>>> result(edges.size());
+  for (size_t vertex = 0; vertex < edges.size(); vertex++) {
+    std::vector<std::pair<size_t, int>>& arcs = result[new_ids[vertex]];
+    arcs.reserve(edges[vertex].size());
+    for (auto edge : edges[vertex]) {
+      arcs.emplace_back(new_ids[edge.first], edge.second);
+    }
+  }
+  return result;
+}
+
+// Dijkstra on the RCM relabeling, with distances mapped back to the
+// original ids.
+std::vector<int> ReorderedDijkstra(
+    std::vector<std::vector<std::pair<size_t, int>>>& edges,
+    size_t vertex_count, size_t start) {
+  std::vector<size_t> new_ids = ReverseCuthillMcKee(edges);
+  std::vector<std::vector<std::pair<size_t, int>>> reordered =
+      Relabel(edges, new_ids);
+  std::vector<int> distances =
+      Dijkstra(reordered, vertex_count, new_ids[start]);
+  std::vector<int> results(vertex_count);
+  for (size_t vertex = 0; vertex < vertex_count; vertex++) {
+    results[vertex] = distances[new_ids[vertex]];
+  }
+  return results;
+}
+// Counts the hardware cache misses of the calling thread between Start and
+// Stop through perf_event_open; Misses() is -1 where the kernel or the
+// machine does not expose the counter.
+class CacheMissCounter {
+ public:
+  CacheMissCounter() {
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    descriptor_ = static_cast<int>(
+        syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+  }
+  CacheMissCounter(const CacheMissCounter&) = delete;
+  CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+  ~CacheMissCounter() {
+    if (descriptor_ >= 0) {
+      close(descriptor_);
+    }
+  }
+  void Start() {
+    if (descriptor_ >= 0) {
+      ioctl(descriptor_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(descriptor_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+  void Stop() {
+    if (descriptor_ >= 0) {
+      ioctl(descriptor_, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  int64_t Misses() const {
+    uint64_t count = 0;
+    if (descriptor_ < 0 ||
+        read(descriptor_, &count, sizeof(count)) != sizeof(count)) {
+      return -1;
+    }
+    return static_cast<int64_t>(count);
+  }
+
+ private:
+  int descriptor_;
+};
+
+// Runs kernel once and prints its wall time and cache misses as one JSON
+// object per line.
+template <class Kernel>
+void ReportKernel(std::string_view name, std::string_view order,
+                  Kernel&& kernel, FastOutput& output) {
+  CacheMissCounter counter;
+  auto begin = std::chrono::steady_clock::now();
+  counter.Start();
+  kernel();
+  counter.Stop();
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  output << "{\"kernel\": \"" << name << "\", \"order\": \"" << order
+         << "\", \"microseconds\": "
+         << std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+                .count()
+         << ", \"cache_misses\": " << counter.Misses() << "}\n";
+}
+
+// "--bench" times the search on the input order and on the RCM order.
+int main(int argc, char** argv) {
+  FastInput input;
+  FastOutput output;
   size_t vertex_count;
   size_t edge_count;
-  std::cin >> vertex_count >> edge_count;
+  input >> vertex_count >> edge_count;
   size_t start;
   size_t end;
-  std::cin >> start >> end;
+  input >> start >> end;
   --start;
   --end;
   std::vector<std::vector<std::pair<size_t, int>>> edges(
@@ -48,12 +345,32 @@ int main() {
     size_t start_edge;
     size_t end_edge;
     int weight;
-    std::cin >> start_edge >> end_edge >> weight;
+    input >> start_edge >> end_edge >> weight;
     --start_edge;
     --end_edge;
     edges[start_edge].emplace_back(end_edge, weight);
   }
+  if (argc == 2 && std::string_view(argv[1]) == "--bench") {
+    Dijkstra(edges, vertex_count, start);
+    ReportKernel(
+        "dijkstra", "input", [&]() { Dijkstra(edges, vertex_count, start); },
+        output);
+    std::vector<size_t> new_ids;
+    std::vector<std::vector<std::pair<size_t, int>>> reordered;
+    ReportKernel(
+        "relabel", "rcm",
+        [&]() {
+          new_ids = ReverseCuthillMcKee(edges);
+          reordered = Relabel(edges, new_ids);
+        },
+        output);
+    Dijkstra(reordered, vertex_count, new_ids[start]);
+    ReportKernel(
+        "dijkstra", "rcm",
+        [&]() { Dijkstra(reordered, vertex_count, new_ids[start]); }, output);
+    return 0;
+  }
   auto results = Dijkstra(edges, vertex_count, start);
-  std::cout << results[end];
+  output << results[end];
   return 0;
 }
\ No newline at end of file
@@ -1,15 +1,173 @@
-#include <iostream>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
 #include <numeric>
 #include <optional>
 #include <queue>
+#include <span>
 #include <stack>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
 template <class VType = size_t, class EType = std::pair<VType, VType>>
 class Graph {
  public:
-  virtual std::vector<VType>& GetNeighbors(const VType&) = 0;
+  virtual std::span<VType> GetNeighbors(const VType&) = 0;
   virtual size_t VertexCount() = 0;
   virtual size_t EdgeCount() = 0;
   virtual const std::vector<VType>& Vertices() = 0;
@@ -33,7 +191,7 @@ class ListGraph : public Graph<VType, EType> {
       }
     }
   }
-  std::vector<VType>& GetNeighbors(const VType& vertex) override {
+  std::span<VType> GetNeighbors(const VType& vertex) override {
     return data_[vertex];
   }
   size_t VertexCount() override { return kVertexCount; }
@@ -54,6 +212,64 @@ class ListGraph : public Graph<VType, EType> {
   std::vector<VType> vertices_;
 };
 
+template <class VType = size_t, class EType = std::pair<VType, VType>,
+          bool ordered = false>
+class CSRListGraph : public Graph<VType, EType> {
+  static_assert(std::is_integral_v<VType>, "CSR storage needs dense ids");
+
+ public:
+  CSRListGraph(const std::vector<VType>& vertices,
+               const std::vector<EType>& edges)
+      : kVertexCount(vertices.size()),
+        kEdgeCount(edges.size()),
+        vertices_(vertices) {
+    VType max_vertex = 0;
+    for (VType vertex : vertices) {
+      max_vertex = std::max(max_vertex, vertex);
+    }
+    for (auto edge : edges) {
+      max_vertex = std::max({max_vertex, edge.first, edge.second});
+    }
+    offsets_.assign(static_cast<size_t>(max_vertex) + 2, 0);
+    for (auto edge : edges) {
+      ++offsets_[edge.first];
+      if constexpr (!ordered) {
+        ++offsets_[edge.second];
+      }
+    }
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    neighbours_.resize(offsets_.back());
+    for (size_t i = edges.size(); i > 0; i--) {
+      const EType& edge = edges[i - 1];
+      if constexpr (!ordered) {
+        neighbours_[--offsets_[edge.second]] = edge.first;
+      }
+      neighbours_[--offsets_[edge.first]] = edge.second;
+    }
+  }
+  std::span<VType> GetNeighbors(const VType& vertex) override {
+    return {neighbours_.data() + offsets_[vertex],
+            neighbours_.data() + offsets_[vertex + 1]};
+  }
+  size_t VertexCount() override { return kVertexCount; }
+  size_t EdgeCount() override { return kEdgeCount; }
+  const std::vector<VType>& Vertices() override { return vertices_; }
+  typename std::vector<VType>::iterator Begin(const VType& vertex) override {
+    return neighbours_.begin() + offsets_[vertex];
+  }
+  typename std::vector<VType>::iterator End(const VType& vertex) override {
+    return neighbours_.begin() + offsets_[vertex + 1];
+  }
+  ~CSRListGraph() = default;
+
+ private:
+  std::vector<size_t> offsets_;
+  std::vector<VType> neighbours_;
+  const size_t kVertexCount;
+  const size_t kEdgeCount;
+  std::vector<VType> vertices_;
+};
+
 template <class VType, class EType>
 class Visitor {
  public:
@@ -78,12 +294,39 @@ class BFSVisitor : public Visitor<VType, EType> {
 
 enum Color { White = 0, Gray, Black };
 
+template <class GraphType>
+size_t IdBound(GraphType& graph) {
+  size_t id_bound = 0;
+  for (auto vertex : graph.Vertices()) {
+    id_bound = std::max(id_bound, static_cast<size_t>(vertex) + 1);
+  }
+  return id_bound;
+}
+
+class ColorArray {
+ public:
+  explicit ColorArray(size_t size) : words_((size + 31) / 32, 0) {}
+  Color Get(size_t index) const {
+    return static_cast<Color>((words_[index / 32] >> (index % 32 * 2)) & 3);
+  }
+  void Set(size_t index, Color color) {
+    uint64_t& word = words_[index / 32];
+    size_t shift = index % 32 * 2;
+    word = (word & ~(uint64_t{3} << shift)) | (uint64_t{color} << shift);
+  }
+  void Reset() { std::fill(words_.begin(), words_.end(), 0); }
+
+ private:
+  std::vector<uint64_t> words_;
+};
+
 template <class VType, class EType>
 std::optional<std::pair<size_t, size_t>> DFS(Graph<VType>& graph,
-                                             Visitor<VType, EType>& visitor) {
-  std::unordered_map<VType, Color> visited;
+                                             Visitor<VType, EType>& visitor,
+                                             ColorArray& visited) {
+  visited.Reset();
   for (VType vertex : graph.Vertices()) {
-    if (visited[vertex] == White) {
+    if (visited.Get(vertex) == White) {
       auto res = DFS(graph, visitor, vertex, visited);
       if (res.has_value()) {
         return res;
@@ -94,49 +337,110 @@ std::optional<std::pair<size_t, size_t>> DFS(Graph<VType>& graph,
 }
 
 template <class VType, class EType>
-std::optional<std::pair<size_t, size_t>> DFS(
-    Graph<VType>& graph, Visitor<VType, EType>& visitor, VType current,
-    std::unordered_map<VType, Color>& visited) {
-  visited[current] = Gray;
-  for (VType neighbour : graph.GetNeighbors(current)) {
-    if (visited[neighbour] == Gray) {
-      return std::make_pair(neighbour, current);
-    }
-    if (visited[neighbour] != Black) {
-      visitor.Visit({current, neighbour});
-      auto res = DFS(graph, visitor, neighbour, visited);
-      if (res.has_value()) {
-        return res;
+std::optional<std::pair<size_t, size_t>> DFS(Graph<VType>& graph,
+                                             Visitor<VType, EType>& visitor) {
+  ColorArray visited(IdBound(graph));
+  return DFS(graph, visitor, visited);
+}
+// Hooks get IsVisited(v), Enter(v), TreeEdge(from, to) before descending,
+// BackEdge(from, to, parent) for edges to visited vertices (false stops the
+// traversal) and Exit(parent, child) once child is finished; the root is
+// its own parent.
+template <class VType, class Neighbours, class Hooks>
+bool IterativeDFS(VType root, Neighbours&& neighbours, Hooks& hooks) {
+  struct Frame {
+    VType vertex;
+    size_t next;
+  };
+  std::vector<Frame> stack;
+  hooks.Enter(root);
+  stack.push_back({root, 0});
+  while (!stack.empty()) {
+    VType current = stack.back().vertex;
+    auto&& adjacent = neighbours(current);
+    if (stack.back().next == adjacent.size()) {
+      stack.pop_back();
+      hooks.Exit(stack.empty() ? current : stack.back().vertex, current);
+      continue;
+    }
+    VType vertex = adjacent[stack.back().next++];
+    if (!hooks.IsVisited(vertex)) {
+      hooks.TreeEdge(current, vertex);
+      hooks.Enter(vertex);
+      stack.push_back({vertex, 0});
+    } else {
+      VType parent =
+          stack.size() > 1 ? stack[stack.size() - 2].vertex : current;
+      if (!hooks.BackEdge(current, vertex, parent)) {
+        return false;
       }
     }
   }
-  visited[current] = Black;
-  return std::nullopt;
+  return true;
+}
+
+template <class VType, class EType>
+class CycleHooks {
+ public:
+  CycleHooks(Visitor<VType, EType>& visitor, ColorArray& visited)
+      : visitor_(visitor), visited_(visited) {}
+  bool IsVisited(const VType& vertex) { return visited_.Get(vertex) != White; }
+  void Enter(const VType& vertex) { visited_.Set(vertex, Gray); }
+  void TreeEdge(const VType& from, const VType& to) {
+    visitor_.Visit({from, to});
+  }
+  bool BackEdge(const VType& from, const VType& to, const VType& parent) {
+    if (visited_.Get(to) == Gray) {
+      cycle_ = std::make_pair(to, from);
+      return false;
+    }
+    return true;
+  }
+  void Exit(const VType& parent, const VType& child) {
+    visited_.Set(child, Black);
+  }
+  std::optional<std::pair<size_t, size_t>> GetCycle() { return cycle_; }
+
+ private:
+  Visitor<VType, EType>& visitor_;
+  ColorArray& visited_;
+  std::optional<std::pair<size_t, size_t>> cycle_;
+};
+
+template <class VType, class EType>
+std::optional<std::pair<size_t, size_t>> DFS(
+    Graph<VType>& graph, Visitor<VType, EType>& visitor, VType current,
+    ColorArray& visited) {
+  CycleHooks<VType, EType> hooks(visitor, visited);
+  IterativeDFS(
+      current,
+      [&graph](const VType& vertex) { return graph.GetNeighbors(vertex); },
+      hooks);
+  return hooks.GetCycle();
 }
 
 int main() {
-  std::ios_base::sync_with_stdio(false);
-  std::cin.tie(nullptr);
-  std::cout.tie(nullptr);
+  FastInput input;
+  FastOutput output;
   size_t vertex_count;
   size_t edge_count;
-  std::cin >> vertex_count >> edge_count;
+  input >> vertex_count >> edge_count;
   std::vector<size_t> vertices(vertex_count);
   std::iota(vertices.begin(), vertices.end(), 1);
   std::vector<std::pair<size_t, size_t>> edges;
   for (size_t i = 0; i < edge_count; i++) {
     size_t first;
     size_t second;
-    std::cin >> first >> second;
+    input >> first >> second;
     edges.emplace_back(first, second);
   }
-  ListGraph<size_t, std::pair<size_t, size_t>, true> graph(vertices, edges);
+  CSRListGraph<size_t, std::pair<size_t, size_t>, true> graph(vertices, edges);
   BFSVisitor<size_t> visitor;
   std::optional<std::pair<size_t, size_t>> points = DFS(graph, visitor);
   auto map = visitor.GetMap();
   std::vector<size_t> result;
   if (!points.has_value()) {
-    std::cout << "NO";
+    output << "NO";
     return 0;
   }
   size_t start = points->first;
@@ -151,8 +455,8 @@ int main() {
     }
   }
   result.push_back(end);
-  std::cout << "YES" << std::endl;
+  output << "YES" << '\n';
   for (size_t i = 1; i <= result.size(); i++) {
-    std::cout << result[result.size() - i] << ' ';
+    output << result[result.size() - i] << ' ';
   }
 }
\ No newline at end of file
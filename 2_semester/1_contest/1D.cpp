@@ -1,13 +1,175 @@
-#include <iostream>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
 #include <numeric>
 #include <queue>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
 template <class VType = size_t, class EType = std::pair<VType, VType>>
 class Graph {
  public:
-  virtual std::vector<VType>& GetNeighbors(const VType&) = 0;
+  virtual std::span<VType> GetNeighbors(const VType&) = 0;
   virtual size_t VertexCount() = 0;
   virtual size_t EdgeCount() = 0;
   virtual const std::vector<VType>& Vertices() = 0;
@@ -31,7 +193,7 @@ class ListGraph : public Graph<VType, EType> {
       }
     }
   }
-  std::vector<VType>& GetNeighbors(const VType& vertex) override {
+  std::span<VType> GetNeighbors(const VType& vertex) override {
     return data_[vertex];
   }
   size_t VertexCount() override { return kVertexCount; }
@@ -52,6 +214,64 @@ class ListGraph : public Graph<VType, EType> {
   std::vector<VType> vertices_;
 };
 
+template <class VType = size_t, class EType = std::pair<VType, VType>,
+          bool ordered = false>
+class CSRListGraph : public Graph<VType, EType> {
+  static_assert(std::is_integral_v<VType>, "CSR storage needs dense ids");
+
+ public:
+  CSRListGraph(const std::vector<VType>& vertices,
+               const std::vector<EType>& edges)
+      : kVertexCount(vertices.size()),
+        kEdgeCount(edges.size()),
+        vertices_(vertices) {
+    VType max_vertex = 0;
+    for (VType vertex : vertices) {
+      max_vertex = std::max(max_vertex, vertex);
+    }
+    for (auto edge : edges) {
+      max_vertex = std::max({max_vertex, edge.first, edge.second});
+    }
+    offsets_.assign(static_cast<size_t>(max_vertex) + 2, 0);
+    for (auto edge : edges) {
+      ++offsets_[edge.first];
+      if constexpr (!ordered) {
+        ++offsets_[edge.second];
+      }
+    }
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    neighbours_.resize(offsets_.back());
+    for (size_t i = edges.size(); i > 0; i--) {
+      const EType& edge = edges[i - 1];
+      if constexpr (!ordered) {
+        neighbours_[--offsets_[edge.second]] = edge.first;
+      }
+      neighbours_[--offsets_[edge.first]] = edge.second;
+    }
+  }
+  std::span<VType> GetNeighbors(const VType& vertex) override {
+    return {neighbours_.data() + offsets_[vertex],
+            neighbours_.data() + offsets_[vertex + 1]};
+  }
+  size_t VertexCount() override { return kVertexCount; }
+  size_t EdgeCount() override { return kEdgeCount; }
+  const std::vector<VType>& Vertices() override { return vertices_; }
+  typename std::vector<VType>::iterator Begin(const VType& vertex) override {
+    return neighbours_.begin() + offsets_[vertex];
+  }
+  typename std::vector<VType>::iterator End(const VType& vertex) override {
+    return neighbours_.begin() + offsets_[vertex + 1];
+  }
+  ~CSRListGraph() = default;
+
+ private:
+  std::vector<size_t> offsets_;
+  std::vector<VType> neighbours_;
+  const size_t kVertexCount;
+  const size_t kEdgeCount;
+  std::vector<VType> vertices_;
+};
+
 template <class VType, class EType>
 class Visitor {
  public:
@@ -70,12 +290,35 @@ class BFSVisitor : public Visitor<VType, EType> {
   std::vector<VType> vector_;
 };
 
+template <class GraphType>
+size_t IdBound(GraphType& graph) {
+  size_t id_bound = 0;
+  for (auto vertex : graph.Vertices()) {
+    id_bound = std::max(id_bound, static_cast<size_t>(vertex) + 1);
+  }
+  return id_bound;
+}
+
+class VisitedBitset {
+ public:
+  explicit VisitedBitset(size_t size) : words_((size + 63) / 64, 0) {}
+  bool Test(size_t index) const {
+    return ((words_[index / 64] >> (index % 64)) & 1) != 0;
+  }
+  void Set(size_t index) { words_[index / 64] |= uint64_t{1} << (index % 64); }
+  void Reset() { std::fill(words_.begin(), words_.end(), 0); }
+
+ private:
+  std::vector<uint64_t> words_;
+};
+
 template <typename VType>
-std::vector<std::vector<VType>> BFS(Graph<VType>& graph) {
+std::vector<std::vector<VType>> BFS(Graph<VType>& graph,
+                                    VisitedBitset& visited) {
+  visited.Reset();
   std::vector<std::vector<VType>> result;
-  std::unordered_map<VType, bool> visited;
   for (VType vertex : graph.Vertices()) {
-    if (!visited[vertex]) {
+    if (!visited.Test(vertex)) {
       BFSVisitor<size_t> visitor;
       BFS(graph, vertex, visitor, visited);
       result.push_back(visitor.GetVector());
@@ -84,50 +327,176 @@ std::vector<std::vector<VType>> BFS(Graph<VType>& graph) {
   return result;
 }
 
+template <typename VType>
+std::vector<std::vector<VType>> BFS(Graph<VType>& graph) {
+  VisitedBitset visited(IdBound(graph));
+  return BFS(graph, visited);
+}
+
 template <class VType, class EType>
 void BFS(Graph<VType>& graph, VType start, Visitor<VType, EType>& visitor,
-         std::unordered_map<VType, bool>& visited) {
+         VisitedBitset& visited) {
   std::queue<VType> queue;
   queue.push(start);
   while (!queue.empty()) {
     VType current = queue.front();
-    if (!visited[current]) {
+    if (!visited.Test(current)) {
       visitor.Visit(current);
       for (VType vertex : graph.GetNeighbors(current)) {
-        if (!visited[vertex]) {
+        if (!visited.Test(vertex)) {
           queue.push(vertex);
         }
       }
     }
-    visited[current] = true;
+    visited.Set(current);
     queue.pop();
   }
 }
 
+template <class Function>
+void ParallelFor(size_t count, size_t thread_count, Function&& function) {
+  static constexpr size_t kChunk = 1024;
+  thread_count = std::max<size_t>(thread_count, 1);
+  std::atomic<size_t> cursor = 0;
+  auto worker = [&]() {
+    for (size_t begin = cursor.fetch_add(kChunk); begin < count;
+         begin = cursor.fetch_add(kChunk)) {
+      size_t end = std::min(begin + kChunk, count);
+      for (size_t i = begin; i < end; i++) {
+        function(i);
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t id = 1; id < thread_count; id++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Concurrent union-find over dense ids where every root is the smallest id of
+// its tree, so linking only ever lowers a parent pointer.
+class ConcurrentLabels {
+ public:
+  explicit ConcurrentLabels(size_t size) : parent_(size) {
+    for (size_t i = 0; i < size; i++) {
+      parent_[i].store(i, std::memory_order_relaxed);
+    }
+  }
+  size_t Get(size_t index) const {
+    return parent_[index].load(std::memory_order_relaxed);
+  }
+  void Link(size_t first, size_t second) {
+    size_t first_parent = Get(first);
+    size_t second_parent = Get(Get(second));
+    while (first_parent != second_parent) {
+      size_t high = std::max(first_parent, second_parent);
+      size_t low = std::min(first_parent, second_parent);
+      size_t high_parent = Get(high);
+      if (high_parent == low ||
+          (high_parent == high &&
+           parent_[high].compare_exchange_strong(high_parent, low))) {
+        break;
+      }
+      first_parent = Get(Get(high));
+      second_parent = Get(low);
+    }
+  }
+  void Compress(size_t index) {
+    while (Get(index) != Get(Get(index))) {
+      parent_[index].store(Get(Get(index)), std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  std::vector<std::atomic<size_t>> parent_;
+};
+
+// Afforest: link the first few neighbours of every vertex, guess the giant
+// component from a sample and finish the remaining edges of the other
+// vertices only. GetNeighbors must be safe to call concurrently, which holds
+// for CSRListGraph.
+template <typename VType>
+std::vector<std::vector<VType>> ParallelComponents(
+    Graph<VType>& graph,
+    size_t thread_count = std::thread::hardware_concurrency()) {
+  static constexpr size_t kNeighbourRounds = 2;
+  static constexpr size_t kSampleSize = 1024;
+  const std::vector<VType>& vertices = graph.Vertices();
+  ConcurrentLabels labels(IdBound(graph));
+  for (size_t round = 0; round < kNeighbourRounds; round++) {
+    ParallelFor(vertices.size(), thread_count, [&](size_t i) {
+      std::span<VType> neighbours = graph.GetNeighbors(vertices[i]);
+      if (round < neighbours.size()) {
+        labels.Link(vertices[i], neighbours[round]);
+      }
+    });
+    ParallelFor(vertices.size(), thread_count,
+                [&](size_t i) { labels.Compress(vertices[i]); });
+  }
+  std::unordered_map<size_t, size_t> frequency;
+  std::mt19937_64 random(vertices.size());
+  for (size_t i = 0; i < kSampleSize && !vertices.empty(); i++) {
+    ++frequency[labels.Get(vertices[random() % vertices.size()])];
+  }
+  size_t giant = std::numeric_limits<size_t>::max();
+  size_t giant_frequency = 0;
+  for (auto [label, count] : frequency) {
+    if (count > giant_frequency) {
+      giant = label;
+      giant_frequency = count;
+    }
+  }
+  ParallelFor(vertices.size(), thread_count, [&](size_t i) {
+    if (labels.Get(vertices[i]) == giant) {
+      return;
+    }
+    std::span<VType> neighbours = graph.GetNeighbors(vertices[i]);
+    for (size_t j = kNeighbourRounds; j < neighbours.size(); j++) {
+      labels.Link(vertices[i], neighbours[j]);
+    }
+  });
+  ParallelFor(vertices.size(), thread_count,
+              [&](size_t i) { labels.Compress(vertices[i]); });
+  std::vector<std::vector<VType>> result;
+  std::vector<size_t> group(IdBound(graph), std::numeric_limits<size_t>::max());
+  for (VType vertex : vertices) {
+    size_t& index = group[labels.Get(vertex)];
+    if (index == std::numeric_limits<size_t>::max()) {
+      index = result.size();
+      result.emplace_back();
+    }
+    result[index].push_back(vertex);
+  }
+  return result;
+}
+
 int main() {
-  std::ios_base::sync_with_stdio(false);
-  std::cin.tie(nullptr);
-  std::cout.tie(nullptr);
+  FastInput input;
+  FastOutput output;
   size_t vertex_count;
   size_t edge_count;
-  std::cin >> vertex_count >> edge_count;
+  input >> vertex_count >> edge_count;
   std::vector<size_t> vertices(vertex_count);
   std::iota(vertices.begin(), vertices.end(), 1);
   std::vector<std::pair<size_t, size_t>> edges;
   for (size_t i = 0; i < edge_count; i++) {
     size_t first;
     size_t second;
-    std::cin >> first >> second;
+    input >> first >> second;
     edges.emplace_back(first, second);
   }
-  ListGraph<size_t> graph(vertices, edges);
-  auto result = BFS(graph);
-  std::cout << result.size() << '\n';
+  CSRListGraph<size_t> graph(vertices, edges);
+  auto result = ParallelComponents(graph);
+  output << result.size() << '\n';
   for (const auto& array : result) {
-    std::cout << array.size() << '\n';
+    output << array.size() << '\n';
     for (auto vertex : array) {
-      std::cout << vertex << ' ';
+      output << vertex << ' ';
     }
-    std::cout << '\n';
+    output << '\n';
   }
 }
\ No newline at end of file
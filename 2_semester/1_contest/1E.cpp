@@ -1,16 +1,176 @@
+#include <unistd.h>
+
 #include <algorithm>
-#include <iostream>
+#include <atomic>
+#include <barrier>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
 #include <numeric>
 #include <optional>
 #include <queue>
+#include <span>
 #include <stack>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
 template <class VType = size_t, class EType = std::pair<VType, VType>>
 class Graph {
  public:
-  virtual std::vector<VType>& GetNeighbors(const VType&) = 0;
+  virtual std::span<VType> GetNeighbors(const VType&) = 0;
   virtual size_t VertexCount() = 0;
   virtual size_t EdgeCount() = 0;
   virtual const std::vector<VType>& Vertices() = 0;
@@ -34,7 +194,7 @@ class ListGraph : public Graph<VType, EType> {
       }
     }
   }
-  std::vector<VType>& GetNeighbors(const VType& vertex) override {
+  std::span<VType> GetNeighbors(const VType& vertex) override {
     return data_[vertex];
   }
   size_t VertexCount() override { return kVertexCount; }
@@ -55,6 +215,64 @@ class ListGraph : public Graph<VType, EType> {
   std::vector<VType> vertices_;
 };
 
+template <class VType = size_t, class EType = std::pair<VType, VType>,
+          bool ordered = false>
+class CSRListGraph : public Graph<VType, EType> {
+  static_assert(std::is_integral_v<VType>, "CSR storage needs dense ids");
+
+ public:
+  CSRListGraph(const std::vector<VType>& vertices,
+               const std::vector<EType>& edges)
+      : kVertexCount(vertices.size()),
+        kEdgeCount(edges.size()),
+        vertices_(vertices) {
+    VType max_vertex = 0;
+    for (VType vertex : vertices) {
+      max_vertex = std::max(max_vertex, vertex);
+    }
+    for (auto edge : edges) {
+      max_vertex = std::max({max_vertex, edge.first, edge.second});
+    }
+    offsets_.assign(static_cast<size_t>(max_vertex) + 2, 0);
+    for (auto edge : edges) {
+      ++offsets_[edge.first];
+      if constexpr (!ordered) {
+        ++offsets_[edge.second];
+      }
+    }
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    neighbours_.resize(offsets_.back());
+    for (size_t i = edges.size(); i > 0; i--) {
+      const EType& edge = edges[i - 1];
+      if constexpr (!ordered) {
+        neighbours_[--offsets_[edge.second]] = edge.first;
+      }
+      neighbours_[--offsets_[edge.first]] = edge.second;
+    }
+  }
+  std::span<VType> GetNeighbors(const VType& vertex) override {
+    return {neighbours_.data() + offsets_[vertex],
+            neighbours_.data() + offsets_[vertex + 1]};
+  }
+  size_t VertexCount() override { return kVertexCount; }
+  size_t EdgeCount() override { return kEdgeCount; }
+  const std::vector<VType>& Vertices() override { return vertices_; }
+  typename std::vector<VType>::iterator Begin(const VType& vertex) override {
+    return neighbours_.begin() + offsets_[vertex];
+  }
+  typename std::vector<VType>::iterator End(const VType& vertex) override {
+    return neighbours_.begin() + offsets_[vertex + 1];
+  }
+  ~CSRListGraph() = default;
+
+ private:
+  std::vector<size_t> offsets_;
+  std::vector<VType> neighbours_;
+  const size_t kVertexCount;
+  const size_t kEdgeCount;
+  std::vector<VType> vertices_;
+};
+
 template <class VType, class EType>
 class Visitor {
  public:
@@ -79,12 +297,38 @@ class BFSVisitor : public Visitor<VType, EType> {
 
 enum Color { White = 0, Gray, Black };
 
+template <class GraphType>
+size_t IdBound(GraphType& graph) {
+  size_t id_bound = 0;
+  for (auto vertex : graph.Vertices()) {
+    id_bound = std::max(id_bound, static_cast<size_t>(vertex) + 1);
+  }
+  return id_bound;
+}
+
+class ColorArray {
+ public:
+  explicit ColorArray(size_t size) : words_((size + 31) / 32, 0) {}
+  Color Get(size_t index) const {
+    return static_cast<Color>((words_[index / 32] >> (index % 32 * 2)) & 3);
+  }
+  void Set(size_t index, Color color) {
+    uint64_t& word = words_[index / 32];
+    size_t shift = index % 32 * 2;
+    word = (word & ~(uint64_t{3} << shift)) | (uint64_t{color} << shift);
+  }
+  void Reset() { std::fill(words_.begin(), words_.end(), 0); }
+
+ private:
+  std::vector<uint64_t> words_;
+};
+
 template <class VType, class EType>
-std::vector<VType> Sort(Graph<VType, EType>& graph) {
+std::vector<VType> Sort(Graph<VType, EType>& graph, ColorArray& visited) {
+  visited.Reset();
   std::vector<VType> result;
-  std::unordered_map<VType, Color> visited;
   for (VType vertex : graph.Vertices()) {
-    if (visited[vertex] == White) {
+    if (visited.Get(vertex) == White) {
       DFS(graph, vertex, visited, result);
     }
   }
@@ -92,51 +336,314 @@ std::vector<VType> Sort(Graph<VType, EType>& graph) {
   return result;
 }
 
+template <class VType, class EType>
+std::vector<VType> Sort(Graph<VType, EType>& graph) {
+  ColorArray visited(IdBound(graph));
+  return Sort(graph, visited);
+}
+
 class HasCycleException : public std::exception {
  public:
   std::string What() { return "Graph contains cycle"; }
 };
 
+// Hooks get IsVisited(v), Enter(v), TreeEdge(from, to) before descending,
+// BackEdge(from, to, parent) for edges to visited vertices (false stops the
+// traversal) and Exit(parent, child) once child is finished; the root is
+// its own parent.
+template <class VType, class Neighbours, class Hooks>
+bool IterativeDFS(VType root, Neighbours&& neighbours, Hooks& hooks) {
+  struct Frame {
+    VType vertex;
+    size_t next;
+  };
+  std::vector<Frame> stack;
+  hooks.Enter(root);
+  stack.push_back({root, 0});
+  while (!stack.empty()) {
+    VType current = stack.back().vertex;
+    auto&& adjacent = neighbours(current);
+    if (stack.back().next == adjacent.size()) {
+      stack.pop_back();
+      hooks.Exit(stack.empty() ? current : stack.back().vertex, current);
+      continue;
+    }
+    VType vertex = adjacent[stack.back().next++];
+    if (!hooks.IsVisited(vertex)) {
+      hooks.TreeEdge(current, vertex);
+      hooks.Enter(vertex);
+      stack.push_back({vertex, 0});
+    } else {
+      VType parent =
+          stack.size() > 1 ? stack[stack.size() - 2].vertex : current;
+      if (!hooks.BackEdge(current, vertex, parent)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <class VType>
+class TopologicalHooks {
+ public:
+  TopologicalHooks(ColorArray& visited, std::vector<VType>& res)
+      : visited_(visited), res_(res) {}
+  bool IsVisited(const VType& vertex) { return visited_.Get(vertex) != White; }
+  void Enter(const VType& vertex) { visited_.Set(vertex, Gray); }
+  void TreeEdge(const VType& from, const VType& to) {}
+  bool BackEdge(const VType& from, const VType& to, const VType& parent) {
+    if (visited_.Get(to) == Gray) {
+      throw HasCycleException();
+    }
+    return true;
+  }
+  void Exit(const VType& parent, const VType& child) {
+    visited_.Set(child, Black);
+    res_.push_back(child);
+  }
+
+ private:
+  ColorArray& visited_;
+  std::vector<VType>& res_;
+};
+
 template <class VType, class EType>
 void DFS(Graph<VType, EType>& graph, VType current,
-         std::unordered_map<VType, Color>& visited, std::vector<VType>& res) {
-  visited[current] = Gray;
-  for (VType neighbour : graph.GetNeighbors(current)) {
-    if (visited[neighbour] == Gray) {
+         ColorArray& visited, std::vector<VType>& res) {
+  TopologicalHooks<VType> hooks(visited, res);
+  IterativeDFS(
+      current,
+      [&graph](const VType& vertex) { return graph.GetNeighbors(vertex); },
+      hooks);
+}
+
+// Pearce-Kelly: an insertion from -> to that breaks the order only touches
+// the vertices ranked between to and from, which are reordered in place.
+template <class VType = size_t>
+class DynamicTopologicalOrder {
+  static_assert(std::is_integral_v<VType>, "positions are indexed by id");
+
+ public:
+  explicit DynamicTopologicalOrder(size_t id_bound)
+      : out_(id_bound),
+        in_(id_bound),
+        position_(id_bound),
+        order_(id_bound),
+        visited_(id_bound, false) {
+    std::iota(position_.begin(), position_.end(), 0);
+    std::iota(order_.begin(), order_.end(), 0);
+  }
+  // Throws HasCycleException and leaves the order untouched if the edge
+  // would close a cycle.
+  void AddEdge(const VType& from, const VType& to) {
+    size_t lower = position_[to];
+    size_t upper = position_[from];
+    if (from == to) {
       throw HasCycleException();
     }
-    if (visited[neighbour] != Black) {
-      DFS(graph, neighbour, visited, res);
+    if (lower < upper) {
+      forward_.clear();
+      backward_.clear();
+      SearchHooks forward_hooks(*this, forward_, from, lower, upper, true);
+      bool acyclic = IterativeDFS(
+          to, [this](const VType& vertex) -> auto& { return out_[vertex]; },
+          forward_hooks);
+      if (!acyclic) {
+        Unmark(forward_);
+        throw HasCycleException();
+      }
+      SearchHooks backward_hooks(*this, backward_, from, lower, upper, false);
+      IterativeDFS(
+          from, [this](const VType& vertex) -> auto& { return in_[vertex]; },
+          backward_hooks);
+      Reorder();
+    }
+    out_[from].push_back(to);
+    in_[to].push_back(from);
+  }
+  size_t Position(const VType& vertex) const { return position_[vertex]; }
+  const std::vector<VType>& GetOrder() const { return order_; }
+
+ private:
+  class SearchHooks {
+   public:
+    SearchHooks(DynamicTopologicalOrder& owner, std::vector<VType>& reached,
+                VType source, size_t lower, size_t upper, bool forward)
+        : owner_(owner),
+          reached_(reached),
+          source_(source),
+          lower_(lower),
+          upper_(upper),
+          forward_(forward) {}
+    bool IsVisited(const VType& vertex) {
+      size_t position = owner_.position_[vertex];
+      return owner_.visited_[vertex] ||
+             (forward_ ? vertex == source_ || position > upper_
+                       : position < lower_);
+    }
+    void Enter(const VType& vertex) {
+      owner_.visited_[vertex] = true;
+      reached_.push_back(vertex);
+    }
+    void TreeEdge(const VType& from, const VType& to) {}
+    bool BackEdge(const VType& from, const VType& to, const VType& parent) {
+      return !forward_ || to != source_;
+    }
+    void Exit(const VType& parent, const VType& child) {}
+
+   private:
+    DynamicTopologicalOrder& owner_;
+    std::vector<VType>& reached_;
+    VType source_;
+    size_t lower_;
+    size_t upper_;
+    bool forward_;
+  };
+
+  void Unmark(const std::vector<VType>& vertices) {
+    for (VType vertex : vertices) {
+      visited_[vertex] = false;
+    }
+  }
+  void Reorder() {
+    auto by_position = [this](const VType& first, const VType& second) {
+      return position_[first] < position_[second];
+    };
+    std::sort(forward_.begin(), forward_.end(), by_position);
+    std::sort(backward_.begin(), backward_.end(), by_position);
+    slots_.clear();
+    for (VType vertex : backward_) {
+      slots_.push_back(position_[vertex]);
+    }
+    for (VType vertex : forward_) {
+      slots_.push_back(position_[vertex]);
+    }
+    std::sort(slots_.begin(), slots_.end());
+    size_t slot = 0;
+    for (const auto* part : {&backward_, &forward_}) {
+      for (VType vertex : *part) {
+        position_[vertex] = slots_[slot];
+        order_[slots_[slot++]] = vertex;
+        visited_[vertex] = false;
+      }
+    }
+  }
+
+  std::vector<std::vector<VType>> out_;
+  std::vector<std::vector<VType>> in_;
+  std::vector<size_t> position_;
+  std::vector<VType> order_;
+  std::vector<bool> visited_;
+  std::vector<VType> forward_;
+  std::vector<VType> backward_;
+  std::vector<size_t> slots_;
+};
+
+// Kahn's algorithm peeling a whole antichain per step: result[i] holds the
+// vertices whose longest path from a source has i edges, so each level can
+// be processed concurrently. Returns std::nullopt if the graph has a cycle.
+template <class VType, class EType>
+std::optional<std::vector<std::vector<VType>>> ParallelLevels(
+    Graph<VType, EType>& graph,
+    size_t thread_count = std::thread::hardware_concurrency()) {
+  static constexpr size_t kChunk = 256;
+  thread_count = std::max<size_t>(thread_count, 1);
+  const std::vector<VType>& vertices = graph.Vertices();
+  std::vector<std::atomic<size_t>> indegree(IdBound(graph));
+  std::vector<std::vector<VType>> levels;
+  std::vector<std::vector<VType>> buffers(thread_count);
+  std::atomic<size_t> cursor = 0;
+  size_t processed = 0;
+  bool finished = false;
+  auto next_level = [&]() noexcept {
+    std::vector<VType> level;
+    if (levels.empty()) {
+      for (VType vertex : vertices) {
+        if (indegree[vertex].load(std::memory_order_relaxed) == 0) {
+          level.push_back(vertex);
+        }
+      }
+    } else {
+      for (auto& buffer : buffers) {
+        level.insert(level.end(), buffer.begin(), buffer.end());
+        buffer.clear();
+      }
+      std::sort(level.begin(), level.end());
+    }
+    cursor.store(0, std::memory_order_relaxed);
+    processed += level.size();
+    finished = level.empty();
+    if (!finished) {
+      levels.push_back(std::move(level));
     }
+  };
+  std::barrier sync(static_cast<std::ptrdiff_t>(thread_count), next_level);
+  auto worker = [&](size_t id) {
+    for (size_t begin = cursor.fetch_add(kChunk); begin < vertices.size();
+         begin = cursor.fetch_add(kChunk)) {
+      size_t end = std::min(begin + kChunk, vertices.size());
+      for (size_t i = begin; i < end; i++) {
+        for (VType vertex : graph.GetNeighbors(vertices[i])) {
+          indegree[vertex].fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    }
+    sync.arrive_and_wait();
+    while (!finished) {
+      const std::vector<VType>& level = levels.back();
+      for (size_t begin = cursor.fetch_add(kChunk); begin < level.size();
+           begin = cursor.fetch_add(kChunk)) {
+        size_t end = std::min(begin + kChunk, level.size());
+        for (size_t i = begin; i < end; i++) {
+          for (VType vertex : graph.GetNeighbors(level[i])) {
+            if (indegree[vertex].fetch_sub(1, std::memory_order_relaxed) ==
+                1) {
+              buffers[id].push_back(vertex);
+            }
+          }
+        }
+      }
+      sync.arrive_and_wait();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t id = 1; id < thread_count; id++) {
+    threads.emplace_back(worker, id);
+  }
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (processed != vertices.size()) {
+    return std::nullopt;
   }
-  visited[current] = Black;
-  res.push_back(current);
+  return levels;
 }
 
 int main() {
-  std::ios_base::sync_with_stdio(false);
-  std::cin.tie(nullptr);
-  std::cout.tie(nullptr);
+  FastInput input;
+  FastOutput output;
   size_t vertex_count;
   size_t edge_count;
-  std::cin >> vertex_count >> edge_count;
+  input >> vertex_count >> edge_count;
   std::vector<size_t> vertices(vertex_count);
   std::iota(vertices.begin(), vertices.end(), 1);
   std::vector<std::pair<size_t, size_t>> edges;
   for (size_t i = 0; i < edge_count; i++) {
     size_t first;
     size_t second;
-    std::cin >> first >> second;
+    input >> first >> second;
     edges.emplace_back(first, second);
   }
-  ListGraph<size_t, std::pair<size_t, size_t>, true> graph(vertices, edges);
+  CSRListGraph<size_t, std::pair<size_t, size_t>, true> graph(vertices, edges);
   try {
     auto result = Sort(graph);
     for (auto res : result) {
-      std::cout << res << ' ';
+      output << res << ' ';
     }
   } catch (HasCycleException& exception) {
-    std::cout << -1;
+    output << -1;
   }
   return 0;
 }
\ No newline at end of file
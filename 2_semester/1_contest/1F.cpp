@@ -1,21 +1,243 @@
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 #include <algorithm>
-#include <iostream>
+#include <atomic>
+#include <barrier>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
 #include <numeric>
 #include <optional>
 #include <queue>
 #include <stack>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
-void DFS(size_t current, std::vector<std::vector<size_t>>& graph,
-         std::vector<bool>& used, std::vector<size_t>& order) {
-  used[current] = true;
-  for (size_t vertex : graph[current]) {
-    if (!used[vertex]) {
-      DFS(vertex, graph, used, order);
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
     }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
   }
-  order.push_back(current);
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
+// Hooks get IsVisited(v), Enter(v), TreeEdge(from, to) before descending,
+// BackEdge(from, to, parent) for edges to visited vertices (false stops the
+// traversal) and Exit(parent, child) once child is finished; the root is
+// its own parent.
+template <class VType, class Neighbours, class Hooks>
+bool IterativeDFS(VType root, Neighbours&& neighbours, Hooks& hooks) {
+  using Iterator = decltype(std::begin(neighbours(root)));
+  struct Frame {
+    VType vertex;
+    Iterator next;
+    Iterator end;
+  };
+  std::vector<Frame> stack;
+  auto push = [&stack, &neighbours](VType vertex) {
+    auto&& adjacent = neighbours(vertex);
+    stack.push_back({vertex, std::begin(adjacent), std::end(adjacent)});
+  };
+  hooks.Enter(root);
+  push(root);
+  while (!stack.empty()) {
+    VType current = stack.back().vertex;
+    if (stack.back().next == stack.back().end) {
+      stack.pop_back();
+      hooks.Exit(stack.empty() ? current : stack.back().vertex, current);
+      continue;
+    }
+    VType vertex = *stack.back().next;
+    ++stack.back().next;
+    if (!hooks.IsVisited(vertex)) {
+      hooks.TreeEdge(current, vertex);
+      hooks.Enter(vertex);
+      push(vertex);
+    } else {
+      VType parent =
+          stack.size() > 1 ? stack[stack.size() - 2].vertex : current;
+      if (!hooks.BackEdge(current, vertex, parent)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+class OrderHooks {
+ public:
+  OrderHooks(std::vector<bool>& used, std::vector<size_t>& order)
+      : used_(used), order_(order) {}
+  bool IsVisited(size_t vertex) { return used_[vertex]; }
+  void Enter(size_t vertex) { used_[vertex] = true; }
+  void TreeEdge(size_t from, size_t to) {}
+  bool BackEdge(size_t from, size_t to, size_t parent) { return true; }
+  void Exit(size_t parent, size_t child) { order_.push_back(child); }
+
+ private:
+  std::vector<bool>& used_;
+  std::vector<size_t>& order_;
+};
+
+void DFS(size_t current, std::vector<std::vector<size_t>>& graph,
+         std::vector<bool>& used, std::vector<size_t>& order) {
+  OrderHooks hooks(used, order);
+  IterativeDFS(
+      current,
+      [&graph](size_t vertex) -> std::vector<size_t>& { return graph[vertex]; },
+      hooks);
 }
 
 std::vector<size_t> Sort(std::vector<std::vector<size_t>>& graph) {
@@ -30,14 +252,28 @@ std::vector<size_t> Sort(std::vector<std::vector<size_t>>& graph) {
   return order;
 }
 
+class ComponentHooks {
+ public:
+  ComponentHooks(std::vector<size_t>& results, size_t count)
+      : results_(results), count_(count) {}
+  bool IsVisited(size_t vertex) { return results_[vertex] != 0; }
+  void Enter(size_t vertex) { results_[vertex] = count_; }
+  void TreeEdge(size_t from, size_t to) {}
+  bool BackEdge(size_t from, size_t to, size_t parent) { return true; }
+  void Exit(size_t parent, size_t child) {}
+
+ private:
+  std::vector<size_t>& results_;
+  size_t count_;
+};
+
 void ComponentDFS(size_t current, std::vector<std::vector<size_t>>& graph,
                   std::vector<size_t>& results, size_t count) {
-  results[current] = count;
-  for (size_t vertex : graph[current]) {
-    if (results[vertex] == 0) {
-      ComponentDFS(vertex, graph, results, count);
-    }
-  }
+  ComponentHooks hooks(results, count);
+  IterativeDFS(
+      current,
+      [&graph](size_t vertex) -> std::vector<size_t>& { return graph[vertex]; },
+      hooks);
 }
 
 size_t FindComponents(std::vector<std::vector<size_t>>& transpose,
@@ -53,30 +289,525 @@ size_t FindComponents(std::vector<std::vector<size_t>>& transpose,
   return count;
 }
 
-int main() {
-  std::ios_base::sync_with_stdio(false);
-  std::cin.tie(nullptr);
-  std::cout.tie(nullptr);
-  size_t vertex_count;
-  size_t edge_count;
-  std::cin >> vertex_count >> edge_count;
-  std::vector<std::vector<size_t>> graph(vertex_count);
+// Pearce's single-array variant of Tarjan: rindex holds the DFS index of an
+// active vertex and the pop number (counting down from kFirstComponent) of a
+// finished one, so no transpose and no separate low array are needed. Both
+// numberings live in Index, so twice the vertex count has to fit in it.
+template <std::unsigned_integral Index>
+class PearceHooks {
+ public:
+  static constexpr Index kExcluded = std::numeric_limits<Index>::max();
+  static constexpr Index kFirstComponent = kExcluded - 1;
+
+  explicit PearceHooks(std::vector<Index>& rindex)
+      : rindex_(rindex), root_(rindex.size(), false) {}
+  bool IsVisited(Index vertex) { return rindex_[vertex] != 0; }
+  void Enter(Index vertex) {
+    rindex_[vertex] = index_++;
+    root_[vertex] = true;
+  }
+  void TreeEdge(Index from, Index to) {}
+  bool BackEdge(Index from, Index to, Index parent) {
+    Lower(from, to);
+    return true;
+  }
+  void Exit(Index parent, Index child) {
+    if (root_[child]) {
+      index_--;
+      while (!stack_.empty() && rindex_[child] <= rindex_[stack_.back()]) {
+        rindex_[stack_.back()] = component_;
+        stack_.pop_back();
+        index_--;
+      }
+      rindex_[child] = component_--;
+    } else {
+      stack_.push_back(child);
+    }
+    if (parent != child) {
+      Lower(parent, child);
+    }
+  }
+  Index PopCount() const { return kFirstComponent - component_; }
+
+ private:
+  void Lower(Index vertex, Index other) {
+    if (rindex_[other] < rindex_[vertex]) {
+      rindex_[vertex] = rindex_[other];
+      root_[vertex] = false;
+    }
+  }
+
+  std::vector<Index>& rindex_;
+  std::vector<bool> root_;
+  std::vector<Index> stack_;
+  Index index_ = 1;
+  Index component_ = kFirstComponent;
+};
+
+// Runs the DFS over every vertex whose rindex is still 0; afterwards
+// kFirstComponent - rindex[v] is the pop number of v's component.
+template <class Adjacency, std::unsigned_integral Index>
+Index PearceDFS(Adjacency& graph, std::vector<Index>& rindex) {
+  PearceHooks<Index> hooks(rindex);
+  for (Index i = 0; i < graph.size(); i++) {
+    if (rindex[i] == 0) {
+      IterativeDFS(
+          i,
+          [&graph](Index vertex) -> decltype(auto) { return graph[vertex]; },
+          hooks);
+    }
+  }
+  return hooks.PopCount();
+}
+
+// Same numbering as FindComponents over the order from Sort: components are
+// popped sinks first by the very same DFS, so the last popped gets number 1.
+template <class Adjacency, std::unsigned_integral Index>
+Index TarjanComponents(Adjacency& graph, std::vector<Index>& results) {
+  results.assign(graph.size(), 0);
+  Index count = PearceDFS(graph, results);
+  for (Index& result : results) {
+    result = count - (PearceHooks<Index>::kFirstComponent - result);
+  }
+  return count;
+}
+
+template <class Function>
+void ParallelFor(size_t count, size_t thread_count, Function&& function) {
+  static constexpr size_t kChunk = 1024;
+  thread_count = std::max<size_t>(thread_count, 1);
+  std::atomic<size_t> cursor = 0;
+  auto worker = [&]() {
+    for (size_t begin = cursor.fetch_add(kChunk); begin < count;
+         begin = cursor.fetch_add(kChunk)) {
+      size_t end = std::min(begin + kChunk, count);
+      for (size_t i = begin; i < end; i++) {
+        function(i);
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t id = 1; id < thread_count; id++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Level-synchronous BFS from start over the vertices with no label yet;
+// bit v of reached is set for every vertex it gets to.
+void ParallelReach(std::vector<std::vector<size_t>>& graph, size_t start,
+                   const std::vector<size_t>& labels,
+                   std::vector<std::atomic<uint64_t>>& reached,
+                   size_t thread_count) {
+  static constexpr size_t kChunk = 64;
+  static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+  thread_count = std::max<size_t>(thread_count, 1);
+  auto claim = [&reached](size_t vertex) {
+    uint64_t mask = uint64_t{1} << (vertex % 64);
+    return (reached[vertex / 64].fetch_or(mask, std::memory_order_relaxed) &
+            mask) == 0;
+  };
+  claim(start);
+  std::vector<size_t> frontier = {start};
+  std::vector<std::vector<size_t>> buffers(thread_count);
+  std::atomic<size_t> cursor = 0;
+  bool finished = false;
+  auto next_level = [&]() noexcept {
+    frontier.clear();
+    for (auto& buffer : buffers) {
+      frontier.insert(frontier.end(), buffer.begin(), buffer.end());
+      buffer.clear();
+    }
+    cursor.store(0, std::memory_order_relaxed);
+    finished = frontier.empty();
+  };
+  std::barrier sync(static_cast<std::ptrdiff_t>(thread_count), next_level);
+  auto worker = [&](size_t id) {
+    while (!finished) {
+      for (size_t begin = cursor.fetch_add(kChunk); begin < frontier.size();
+           begin = cursor.fetch_add(kChunk)) {
+        size_t end = std::min(begin + kChunk, frontier.size());
+        for (size_t i = begin; i < end; i++) {
+          for (size_t vertex : graph[frontier[i]]) {
+            if (labels[vertex] == kNone && claim(vertex)) {
+              buffers[id].push_back(vertex);
+            }
+          }
+        }
+      }
+      sync.arrive_and_wait();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t id = 1; id < thread_count; id++) {
+    threads.emplace_back(worker, id);
+  }
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Multistep SCC: trims vertices without live in- or out-edges, peels the
+// SCC of the highest-degree pivot with parallel forward and backward
+// reachability and leaves the small remainder to PearceDFS. Components are
+// then numbered in topological order of the condensation, as with
+// FindComponents, though ties may be broken differently.
+size_t ParallelComponents(
+    std::vector<std::vector<size_t>>& graph, std::vector<size_t>& results,
+    size_t thread_count = std::thread::hardware_concurrency()) {
+  static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+  static constexpr size_t kTrimRounds = 3;
+  size_t vertex_count = graph.size();
   std::vector<std::vector<size_t>> transpose(vertex_count);
+  for (size_t i = 0; i < vertex_count; i++) {
+    for (size_t vertex : graph[i]) {
+      transpose[vertex].push_back(i);
+    }
+  }
+  std::vector<size_t> labels(vertex_count, kNone);
+  std::vector<uint8_t> trimmed(vertex_count, 0);
+  auto live_degree = [&labels](const std::vector<size_t>& neighbours) {
+    return std::count_if(neighbours.begin(), neighbours.end(),
+                         [&labels](size_t vertex) {
+                           return labels[vertex] == kNone;
+                         });
+  };
+  for (size_t round = 0; round < kTrimRounds; round++) {
+    ParallelFor(vertex_count, thread_count, [&](size_t i) {
+      trimmed[i] = labels[i] == kNone && (live_degree(graph[i]) == 0 ||
+                                          live_degree(transpose[i]) == 0);
+    });
+    for (size_t i = 0; i < vertex_count; i++) {
+      if (trimmed[i] != 0) {
+        labels[i] = i;
+      }
+    }
+  }
+  size_t pivot = kNone;
+  size_t best = 0;
+  for (size_t i = 0; i < vertex_count; i++) {
+    size_t weight = (graph[i].size() + 1) * (transpose[i].size() + 1);
+    if (labels[i] == kNone && (pivot == kNone || weight > best)) {
+      pivot = i;
+      best = weight;
+    }
+  }
+  if (pivot != kNone) {
+    std::vector<std::atomic<uint64_t>> forward((vertex_count + 63) / 64);
+    std::vector<std::atomic<uint64_t>> backward((vertex_count + 63) / 64);
+    ParallelReach(graph, pivot, labels, forward, thread_count);
+    ParallelReach(transpose, pivot, labels, backward, thread_count);
+    for (size_t i = 0; i < vertex_count; i++) {
+      uint64_t mask = uint64_t{1} << (i % 64);
+      if ((forward[i / 64].load() & backward[i / 64].load() & mask) != 0) {
+        labels[i] = pivot;
+      }
+    }
+  }
+  std::vector<size_t> rindex(vertex_count, 0);
+  for (size_t i = 0; i < vertex_count; i++) {
+    if (labels[i] != kNone) {
+      rindex[i] = PearceHooks<size_t>::kExcluded;
+    }
+  }
+  PearceDFS(graph, rindex);
+  for (size_t i = 0; i < vertex_count; i++) {
+    if (labels[i] == kNone) {
+      labels[i] =
+          vertex_count + (PearceHooks<size_t>::kFirstComponent - rindex[i]);
+    }
+  }
+  std::vector<size_t> compact(2 * vertex_count, kNone);
+  size_t count = 0;
+  for (size_t& label : labels) {
+    if (compact[label] == kNone) {
+      compact[label] = count++;
+    }
+    label = compact[label];
+  }
+  std::vector<std::vector<size_t>> condensed(count);
+  std::vector<size_t> indegree(count, 0);
+  for (size_t i = 0; i < vertex_count; i++) {
+    for (size_t vertex : graph[i]) {
+      if (labels[i] != labels[vertex]) {
+        condensed[labels[i]].push_back(labels[vertex]);
+        indegree[labels[vertex]]++;
+      }
+    }
+  }
+  std::vector<size_t> number(count, 0);
+  std::queue<size_t> queue;
+  for (size_t i = 0; i < count; i++) {
+    if (indegree[i] == 0) {
+      queue.push(i);
+    }
+  }
+  for (size_t next = 1; !queue.empty(); queue.pop()) {
+    number[queue.front()] = next++;
+    for (size_t component : condensed[queue.front()]) {
+      if (--indegree[component] == 0) {
+        queue.push(component);
+      }
+    }
+  }
+  results.resize(vertex_count);
+  for (size_t i = 0; i < vertex_count; i++) {
+    results[i] = number[labels[i]];
+  }
+  return count;
+}
+
+// Appends value as a base-128 varint: seven bits per byte, low bits first,
+// with the high bit set on every byte but the last.
+void PutVarint(std::vector<uint8_t>& bytes, uint64_t value) {
+  while (value >= 0x80) {
+    bytes.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  bytes.push_back(static_cast<uint8_t>(value));
+}
+
+inline uint64_t GetVarint(const uint8_t*& cursor) {
+  uint64_t value = *cursor++;
+  if (value < 0x80) {
+    return value;
+  }
+  value &= 0x7f;
+  for (unsigned shift = 7;; shift += 7) {
+    uint64_t byte = *cursor++;
+    value |= (byte & 0x7f) << shift;
+    if (byte < 0x80) {
+      return value;
+    }
+  }
+}
+
+// Adjacency lists sorted and gap encoded as varints: the first neighbour is
+// stored as its zigzagged difference from the vertex, every other one as
+// its difference from the previous. graph[vertex] decodes on the fly, so
+// the traversals take it in place of the nested vectors; neighbours come
+// back in increasing order.
+class CompressedAdjacency {
+ public:
+  class Neighbours {
+   public:
+    class Iterator {
+     public:
+      using value_type = size_t;
+      using difference_type = std::ptrdiff_t;
+
+      Iterator() = default;
+      Iterator(const uint8_t* cursor, const uint8_t* end, size_t vertex)
+          : cursor_(cursor), next_(cursor), end_(end) {
+        if (cursor_ != end_) {
+          uint64_t gap = GetVarint(next_);
+          value_ = vertex + ((gap >> 1) ^ (0 - (gap & 1)));
+        }
+      }
+      size_t operator*() const { return value_; }
+      Iterator& operator++() {
+        cursor_ = next_;
+        if (cursor_ != end_) {
+          value_ += GetVarint(next_);
+        }
+        return *this;
+      }
+      Iterator operator++(int) {
+        Iterator previous = *this;
+        ++*this;
+        return previous;
+      }
+      bool operator==(const Iterator& other) const {
+        return cursor_ == other.cursor_;
+      }
+
+     private:
+      const uint8_t* cursor_ = nullptr;
+      const uint8_t* next_ = nullptr;
+      const uint8_t* end_ = nullptr;
+      size_t value_ = 0;
+    };
+
+    Neighbours(const uint8_t* begin, const uint8_t* end, size_t vertex)
+        : begin_(begin), end_(end), vertex_(vertex) {}
+    Iterator begin() const { return {begin_, end_, vertex_}; }
+    Iterator end() const { return {end_, end_, vertex_}; }
+
+   private:
+    const uint8_t* begin_;
+    const uint8_t* end_;
+    size_t vertex_;
+  };
+
+  template <std::unsigned_integral Index>
+  explicit CompressedAdjacency(const std::vector<std::vector<Index>>& graph)
+      : offsets_(graph.size() + 1, 0) {
+    std::vector<size_t> sorted;
+    for (size_t vertex = 0; vertex < graph.size(); vertex++) {
+      sorted.assign(graph[vertex].begin(), graph[vertex].end());
+      std::sort(sorted.begin(), sorted.end());
+      size_t previous = vertex;
+      for (size_t i = 0; i < sorted.size(); i++) {
+        uint64_t gap = sorted[i] - previous;
+        PutVarint(bytes_, i == 0 ? (gap << 1) ^ (0 - (gap >> 63)) : gap);
+        previous = sorted[i];
+      }
+      offsets_[vertex + 1] = bytes_.size();
+    }
+    bytes_.shrink_to_fit();
+  }
+  size_t size() const { return offsets_.size() - 1; }
+  Neighbours operator[](size_t vertex) const {
+    return {bytes_.data() + offsets_[vertex],
+            bytes_.data() + offsets_[vertex + 1], vertex};
+  }
+  size_t ByteSize() const {
+    return offsets_.size() * sizeof(uint64_t) + bytes_.size();
+  }
+
+ private:
+  std::vector<uint64_t> offsets_;
+  std::vector<uint8_t> bytes_;
+};
+
+
+// Counts the hardware cache misses of the calling thread between Start and
+// Stop through perf_event_open; Misses() is -1 where the kernel or the
+// machine does not expose the counter.
+class CacheMissCounter {
+ public:
+  CacheMissCounter() {
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    descriptor_ = static_cast<int>(
+        syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+  }
+  CacheMissCounter(const CacheMissCounter&) = delete;
+  CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+  ~CacheMissCounter() {
+    if (descriptor_ >= 0) {
+      close(descriptor_);
+    }
+  }
+  void Start() {
+    if (descriptor_ >= 0) {
+      ioctl(descriptor_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(descriptor_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+  void Stop() {
+    if (descriptor_ >= 0) {
+      ioctl(descriptor_, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  int64_t Misses() const {
+    uint64_t count = 0;
+    if (descriptor_ < 0 ||
+        read(descriptor_, &count, sizeof(count)) != sizeof(count)) {
+      return -1;
+    }
+    return static_cast<int64_t>(count);
+  }
+
+ private:
+  int descriptor_;
+};
+
+// Runs kernel once and prints its wall time and cache misses as one JSON
+// object per line.
+template <class Kernel>
+void ReportKernel(std::string_view name, std::string_view order,
+                  Kernel&& kernel, FastOutput& output) {
+  CacheMissCounter counter;
+  auto begin = std::chrono::steady_clock::now();
+  counter.Start();
+  kernel();
+  counter.Stop();
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  output << "{\"kernel\": \"" << name << "\", \"order\": \"" << order
+         << "\", \"microseconds\": "
+         << std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+                .count()
+         << ", \"cache_misses\": " << counter.Misses() << "}\n";
+}
+
+// Prints the bytes an adjacency layout takes as one JSON object per line.
+void ReportBytes(std::string_view layout, size_t bytes, FastOutput& output) {
+  output << "{\"layout\": \"" << layout << "\", \"bytes\": " << bytes
+         << "}\n";
+}
+
+// Heap bytes held by nested adjacency vectors, allocator overhead aside.
+template <class T>
+size_t NestedBytes(const std::vector<std::vector<T>>& lists) {
+  size_t bytes = lists.capacity() * sizeof(std::vector<T>);
+  for (const std::vector<T>& list : lists) {
+    bytes += list.capacity() * sizeof(T);
+  }
+  return bytes;
+}
+
+// Reads the arcs into lists of Index ids and prints the components.
+template <std::unsigned_integral Index>
+void Solve(size_t vertex_count, size_t edge_count, bool bench,
+           FastInput& input, FastOutput& output) {
+  std::vector<std::vector<Index>> graph(vertex_count);
   for (size_t i = 0; i < edge_count; i++) {
-    size_t start;
-    size_t end;
-    std::cin >> start >> end;
+    Index start;
+    Index end;
+    input >> start >> end;
     start--;
     end--;
     graph[start].push_back(end);
-    transpose[end].push_back(start);
   }
-  std::vector<size_t> order = Sort(graph);
-  std::vector<size_t> results(vertex_count, 0);
-  size_t count = FindComponents(transpose, order, results);
-  std::cout << count << std::endl;
-  for (size_t i : results) {
-    std::cout << i << " ";
+  std::vector<Index> results;
+  if (bench) {
+    CompressedAdjacency compressed(graph);
+    for (std::vector<Index>& list : graph) {
+      std::sort(list.begin(), list.end());
+    }
+    ReportBytes("nested", NestedBytes(graph), output);
+    ReportBytes("compressed", compressed.ByteSize(), output);
+    TarjanComponents(graph, results);
+    ReportKernel(
+        "tarjan", "sorted", [&]() { TarjanComponents(graph, results); },
+        output);
+    TarjanComponents(compressed, results);
+    ReportKernel(
+        "tarjan", "compressed",
+        [&]() { TarjanComponents(compressed, results); }, output);
+    return;
+  }
+  Index count = TarjanComponents(graph, results);
+  output << count << '\n';
+  for (Index i : results) {
+    output << i << " ";
+  }
+}
+
+// Ids are 32-bit unless the vertex count needs more. "--bench" prints the
+// memory of the nested and the compressed adjacency and times
+// TarjanComponents on both, with the nested lists sorted the same way.
+int main(int argc, char** argv) {
+  FastInput input;
+  FastOutput output;
+  size_t vertex_count;
+  size_t edge_count;
+  input >> vertex_count >> edge_count;
+  bool bench = argc == 2 && std::string_view(argv[1]) == "--bench";
+  if (vertex_count < std::numeric_limits<uint32_t>::max() / 2) {
+    Solve<uint32_t>(vertex_count, edge_count, bench, input, output);
+  } else {
+    Solve<uint64_t>(vertex_count, edge_count, bench, input, output);
   }
   return 0;
-}
\ No newline at end of file
+}
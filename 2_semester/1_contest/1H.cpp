@@ -1,13 +1,171 @@
+#include <unistd.h>
+
 #include <algorithm>
-#include <iostream>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstdlib>
+#include <limits>
 #include <numeric>
 #include <optional>
 #include <queue>
 #include <set>
+#include <span>
 #include <stack>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
 static constexpr size_t kInfty = std::numeric_limits<size_t>::max();
 
 struct State {
@@ -23,45 +181,295 @@ struct State {
         time_up(std::vector<size_t>(vertex_count, kInfty)) {}
 };
 
-void DFS(size_t current, size_t parent, std::vector<std::vector<size_t>>& graph,
-         State& state, bool root = true) {
-  state.used[current] = true;
-  state.time_in[current] = state.time++;
-  state.time_up[current] = state.time_in[current];
-  size_t children_count = 0;
-  for (size_t vertex : graph[current]) {
-    if (root || vertex != parent) {
-      if (!state.used[vertex]) {
-        DFS(vertex, current, graph, state, false);
-        state.time_up[current] =
-            std::min(state.time_up[current], state.time_up[vertex]);
-        if (state.time_up[vertex] >= state.time_in[current] && !root) {
-          state.result.insert(current);
-        }
-        children_count++;
-      } else {
-        state.time_up[current] =
-            std::min(state.time_up[current], state.time_in[vertex]);
+// Hooks get IsVisited(v), Enter(v), TreeEdge(from, to) before descending,
+// BackEdge(from, to, parent) for edges to visited vertices (false stops the
+// traversal) and Exit(parent, child) once child is finished; the root is
+// its own parent.
+template <class VType, class Neighbours, class Hooks>
+bool IterativeDFS(VType root, Neighbours&& neighbours, Hooks& hooks) {
+  struct Frame {
+    VType vertex;
+    size_t next;
+  };
+  std::vector<Frame> stack;
+  hooks.Enter(root);
+  stack.push_back({root, 0});
+  while (!stack.empty()) {
+    VType current = stack.back().vertex;
+    auto&& adjacent = neighbours(current);
+    if (stack.back().next == adjacent.size()) {
+      stack.pop_back();
+      hooks.Exit(stack.empty() ? current : stack.back().vertex, current);
+      continue;
+    }
+    VType vertex = adjacent[stack.back().next++];
+    if (!hooks.IsVisited(vertex)) {
+      hooks.TreeEdge(current, vertex);
+      hooks.Enter(vertex);
+      stack.push_back({vertex, 0});
+    } else {
+      VType parent =
+          stack.size() > 1 ? stack[stack.size() - 2].vertex : current;
+      if (!hooks.BackEdge(current, vertex, parent)) {
+        return false;
       }
     }
   }
-  if (root && children_count >= 2) {
-    state.result.insert(current);
+  return true;
+}
+
+class ArticulationHooks {
+ public:
+  ArticulationHooks(State& state, size_t root) : state_(state), root_(root) {}
+  bool IsVisited(size_t vertex) { return state_.used[vertex]; }
+  void Enter(size_t vertex) {
+    state_.used[vertex] = true;
+    state_.time_in[vertex] = state_.time++;
+    state_.time_up[vertex] = state_.time_in[vertex];
   }
+  void TreeEdge(size_t from, size_t to) {
+    if (from == root_) {
+      ++children_count_;
+    }
+  }
+  bool BackEdge(size_t from, size_t to, size_t parent) {
+    if (from == root_ || to != parent) {
+      state_.time_up[from] =
+          std::min(state_.time_up[from], state_.time_in[to]);
+    }
+    return true;
+  }
+  void Exit(size_t parent, size_t child) {
+    if (parent == child) {
+      if (children_count_ >= 2) {
+        state_.result.insert(child);
+      }
+      return;
+    }
+    state_.time_up[parent] =
+        std::min(state_.time_up[parent], state_.time_up[child]);
+    if (state_.time_up[child] >= state_.time_in[parent] && parent != root_) {
+      state_.result.insert(parent);
+    }
+  }
+
+ private:
+  State& state_;
+  size_t root_;
+  size_t children_count_ = 0;
+};
+
+void DFS(size_t root, std::vector<std::vector<size_t>>& graph, State& state) {
+  ArticulationHooks hooks(state, root);
+  IterativeDFS(
+      root,
+      [&graph](size_t vertex) -> std::vector<size_t>& { return graph[vertex]; },
+      hooks);
 }
 
+class BlockHooks {
+ public:
+  BlockHooks(std::vector<size_t>& time_in, std::vector<size_t>& time_up,
+             std::vector<std::vector<size_t>>& blocks)
+      : time_in_(time_in), time_up_(time_up), blocks_(blocks) {}
+  bool IsVisited(size_t vertex) { return time_in_[vertex] != kInfty; }
+  void Enter(size_t vertex) {
+    time_in_[vertex] = time_++;
+    time_up_[vertex] = time_in_[vertex];
+    stack_.push_back(vertex);
+  }
+  void TreeEdge(size_t from, size_t to) {}
+  bool BackEdge(size_t from, size_t to, size_t parent) {
+    if (to != parent) {
+      time_up_[from] = std::min(time_up_[from], time_in_[to]);
+    }
+    return true;
+  }
+  void Exit(size_t parent, size_t child) {
+    if (parent == child) {
+      stack_.pop_back();
+      return;
+    }
+    time_up_[parent] = std::min(time_up_[parent], time_up_[child]);
+    if (time_up_[child] >= time_in_[parent]) {
+      std::vector<size_t>& block = blocks_.emplace_back();
+      do {
+        block.push_back(stack_.back());
+        stack_.pop_back();
+      } while (block.back() != child);
+      block.push_back(parent);
+    }
+  }
+
+ private:
+  std::vector<size_t>& time_in_;
+  std::vector<size_t>& time_up_;
+  std::vector<std::vector<size_t>>& blocks_;
+  std::vector<size_t> stack_;
+  size_t time_ = 0;
+};
+
+class TourHooks {
+ public:
+  TourHooks(std::vector<size_t>& time_in, std::vector<size_t>& time_out,
+            std::vector<size_t>& depth, std::vector<size_t>& first,
+            std::vector<size_t>& euler)
+      : time_in_(time_in),
+        time_out_(time_out),
+        depth_(depth),
+        first_(first),
+        euler_(euler) {}
+  bool IsVisited(size_t node) { return time_in_[node] != kInfty; }
+  void Enter(size_t node) {
+    time_in_[node] = time_++;
+    first_[node] = euler_.size();
+    euler_.push_back(node);
+  }
+  void TreeEdge(size_t from, size_t to) { depth_[to] = depth_[from] + 1; }
+  bool BackEdge(size_t from, size_t to, size_t parent) { return true; }
+  void Exit(size_t parent, size_t child) {
+    time_out_[child] = time_++;
+    if (parent != child) {
+      euler_.push_back(parent);
+    }
+  }
+
+ private:
+  std::vector<size_t>& time_in_;
+  std::vector<size_t>& time_out_;
+  std::vector<size_t>& depth_;
+  std::vector<size_t>& first_;
+  std::vector<size_t>& euler_;
+  size_t time_ = 0;
+};
+
+// Nodes [0, n) are the vertices of the graph and [n, n + BlockCount()) its
+// biconnected blocks; a vertex is a cut vertex iff it touches two blocks,
+// and it separates a from b iff it lies on their tree path, which an Euler
+// tour with a sparse table over depths answers in O(1).
+class BlockCutTree {
+ public:
+  explicit BlockCutTree(std::vector<std::vector<size_t>>& graph)
+      : vertex_count_(graph.size()) {
+    std::vector<size_t> time_in(vertex_count_, kInfty);
+    std::vector<size_t> time_up(vertex_count_, kInfty);
+    std::vector<std::vector<size_t>> blocks;
+    BlockHooks block_hooks(time_in, time_up, blocks);
+    for (size_t i = 0; i < vertex_count_; i++) {
+      if (time_in[i] == kInfty) {
+        IterativeDFS(
+            i,
+            [&graph](size_t vertex) -> std::vector<size_t>& {
+              return graph[vertex];
+            },
+            block_hooks);
+      }
+    }
+    size_t node_count = vertex_count_ + blocks.size();
+    offsets_.assign(node_count + 1, 0);
+    for (size_t i = 0; i < blocks.size(); i++) {
+      offsets_[vertex_count_ + i + 1] = blocks[i].size();
+      for (size_t vertex : blocks[i]) {
+        offsets_[vertex + 1]++;
+      }
+    }
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    neighbours_.resize(offsets_.back());
+    std::vector<size_t> fill(offsets_.begin(), offsets_.end() - 1);
+    for (size_t i = 0; i < blocks.size(); i++) {
+      for (size_t vertex : blocks[i]) {
+        neighbours_[fill[vertex]++] = vertex_count_ + i;
+        neighbours_[fill[vertex_count_ + i]++] = vertex;
+      }
+    }
+    BuildIndex(node_count);
+  }
+  size_t BlockCount() const { return offsets_.size() - 1 - vertex_count_; }
+  std::span<const size_t> GetNeighbors(size_t node) const {
+    return {neighbours_.data() + offsets_[node],
+            neighbours_.data() + offsets_[node + 1]};
+  }
+  bool IsCutVertex(size_t vertex) const {
+    return offsets_[vertex + 1] - offsets_[vertex] >= 2;
+  }
+  // Whether every path from first to second passes through vertex.
+  bool Separates(size_t vertex, size_t first, size_t second) const {
+    if (vertex == first || vertex == second || !IsCutVertex(vertex) ||
+        component_[first] != component_[second]) {
+      return false;
+    }
+    size_t lca = Lca(first, second);
+    return IsAncestor(lca, vertex) &&
+           (IsAncestor(vertex, first) || IsAncestor(vertex, second));
+  }
+
+ private:
+  void BuildIndex(size_t node_count) {
+    std::vector<size_t> time_in(node_count, kInfty);
+    time_out_.assign(node_count, 0);
+    depth_.assign(node_count, 0);
+    first_.assign(node_count, 0);
+    component_.assign(node_count, 0);
+    std::vector<size_t> euler;
+    TourHooks hooks(time_in, time_out_, depth_, first_, euler);
+    for (size_t i = 0; i < node_count; i++) {
+      if (time_in[i] == kInfty) {
+        size_t begin = euler.size();
+        IterativeDFS(
+            i, [this](size_t node) { return GetNeighbors(node); }, hooks);
+        for (size_t j = begin; j < euler.size(); j++) {
+          component_[euler[j]] = i;
+        }
+      }
+    }
+    time_in_ = std::move(time_in);
+    sparse_.assign(1, euler);
+    for (size_t width = 1; 2 * width <= euler.size(); width *= 2) {
+      const std::vector<size_t>& below = sparse_.back();
+      std::vector<size_t> level(euler.size() - 2 * width + 1);
+      for (size_t i = 0; i < level.size(); i++) {
+        level[i] = Shallower(below[i], below[i + width]);
+      }
+      sparse_.push_back(std::move(level));
+    }
+  }
+  size_t Shallower(size_t first, size_t second) const {
+    return depth_[first] <= depth_[second] ? first : second;
+  }
+  bool IsAncestor(size_t ancestor, size_t node) const {
+    return time_in_[ancestor] <= time_in_[node] &&
+           time_out_[node] <= time_out_[ancestor];
+  }
+  size_t Lca(size_t first, size_t second) const {
+    size_t left = std::min(first_[first], first_[second]);
+    size_t right = std::max(first_[first], first_[second]) + 1;
+    size_t level = std::bit_width(right - left) - 1;
+    return Shallower(sparse_[level][left],
+                     sparse_[level][right - (size_t{1} << level)]);
+  }
+
+  size_t vertex_count_;
+  std::vector<size_t> offsets_;
+  std::vector<size_t> neighbours_;
+  std::vector<size_t> time_in_;
+  std::vector<size_t> time_out_;
+  std::vector<size_t> depth_;
+  std::vector<size_t> first_;
+  std::vector<size_t> component_;
+  std::vector<std::vector<size_t>> sparse_;
+};
+
 int main() {
-  std::ios_base::sync_with_stdio(false);
-  std::cin.tie(nullptr);
-  std::cout.tie(nullptr);
+  FastInput input;
+  FastOutput output;
   size_t vertex_count;
   size_t edge_count;
-  std::cin >> vertex_count >> edge_count;
+  input >> vertex_count >> edge_count;
   std::vector<std::vector<size_t>> graph(vertex_count);
   for (size_t i = 0; i < edge_count; i++) {
     size_t start;
     size_t end;
-    std::cin >> start >> end;
+    input >> start >> end;
     start--;
     end--;
     graph[start].push_back(end);
@@ -70,12 +478,12 @@ int main() {
   State state(vertex_count);
   for (size_t i = 0; i < vertex_count; i++) {
     if (!state.used[i]) {
-      DFS(i, 0, graph, state);
+      DFS(i, graph, state);
     }
   }
-  std::cout << state.result.size() << '\n';
+  output << state.result.size() << '\n';
   for (size_t vertex : state.result) {
-    std::cout << vertex + 1 << '\n';
+    output << vertex + 1 << '\n';
   }
   return 0;
 }
\ No newline at end of file
@@ -1,16 +1,179 @@
 // 123
+#include <unistd.h>
+
 #include <algorithm>
-#include <iostream>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
 #include <limits>
 #include <numeric>
+#include <ranges>
 #include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
 template <class VType = size_t, class EType = std::pair<VType, VType>>
 class Graph {
  public:
-  virtual std::vector<VType>& GetNeighbors(const VType&) = 0;
+  using VertexType = VType;
+  using EdgeType = EType;
+  virtual std::span<VType> GetNeighbors(const VType&) = 0;
   virtual size_t VertexCount() = 0;
   virtual size_t EdgeCount() = 0;
   virtual const std::vector<VType>& Vertices() = 0;
@@ -23,7 +186,7 @@ class Graph {
 
 template <class VType = size_t, class EType = std::pair<VType, VType>,
           bool ordered = false>
-class ListGraph : public Graph<VType, EType> {
+class ListGraph final : public Graph<VType, EType> {
  public:
   ListGraph(const std::vector<VType>& vertices, const std::vector<EType>& edges)
       : kVertexCount(vertices.size()),
@@ -36,7 +199,7 @@ class ListGraph : public Graph<VType, EType> {
       }
     }
   }
-  std::vector<VType>& GetNeighbors(const VType& vertex) override {
+  std::span<VType> GetNeighbors(const VType& vertex) override {
     return data_[vertex];
   }
   size_t VertexCount() override { return kVertexCount; }
@@ -59,6 +222,161 @@ class ListGraph : public Graph<VType, EType> {
   std::vector<VType> vertices_;
 };
 
+template <class VType = size_t, class EType = std::pair<VType, VType>,
+          bool ordered = false>
+class CSRListGraph final : public Graph<VType, EType> {
+  static_assert(std::is_integral_v<VType>, "CSR storage needs dense ids");
+
+ public:
+  CSRListGraph(const std::vector<VType>& vertices,
+               const std::vector<EType>& edges)
+      : kVertexCount(vertices.size()),
+        kEdgeCount(edges.size()),
+        vertices_(vertices) {
+    VType max_vertex = 0;
+    for (VType vertex : vertices) {
+      max_vertex = std::max(max_vertex, vertex);
+    }
+    for (auto edge : edges) {
+      max_vertex = std::max({max_vertex, edge.first, edge.second});
+    }
+    offsets_.assign(static_cast<size_t>(max_vertex) + 2, 0);
+    for (auto edge : edges) {
+      ++offsets_[edge.first];
+      if constexpr (!ordered) {
+        ++offsets_[edge.second];
+      }
+    }
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    neighbours_.resize(offsets_.back());
+    for (size_t i = edges.size(); i > 0; i--) {
+      const EType& edge = edges[i - 1];
+      if constexpr (!ordered) {
+        neighbours_[--offsets_[edge.second]] = edge.first;
+      }
+      neighbours_[--offsets_[edge.first]] = edge.second;
+    }
+  }
+  std::span<VType> GetNeighbors(const VType& vertex) override {
+    return {neighbours_.data() + offsets_[vertex],
+            neighbours_.data() + offsets_[vertex + 1]};
+  }
+  size_t VertexCount() override { return kVertexCount; }
+  size_t EdgeCount() override { return kEdgeCount; }
+  const std::vector<VType>& Vertices() override { return vertices_; }
+  // NOLINTNEXTLINE
+  typename std::vector<VType>::iterator begin(const VType& vertex) override {
+    return neighbours_.begin() + offsets_[vertex];
+  }
+  // NOLINTNEXTLINE
+  typename std::vector<VType>::iterator end(const VType& vertex) override {
+    return neighbours_.begin() + offsets_[vertex + 1];
+  }
+  ~CSRListGraph() = default;
+
+ private:
+  std::vector<size_t> offsets_;
+  std::vector<VType> neighbours_;
+  const size_t kVertexCount;
+  const size_t kEdgeCount;
+  std::vector<VType> vertices_;
+};
+
+// Parallel edges collapse into one adjacency entry that keeps the id of the
+// last of them and their count, so callers read both in O(1) from the
+// position of the neighbour instead of looking the pair up.
+template <class VType = size_t, class EType = std::pair<VType, VType>,
+          bool ordered = false>
+class EdgeIdCSRListGraph final : public Graph<VType, EType> {
+  static_assert(std::is_integral_v<VType>, "CSR storage needs dense ids");
+
+ public:
+  EdgeIdCSRListGraph(const std::vector<VType>& vertices,
+                     const std::vector<EType>& edges,
+                     const std::vector<size_t>& ids)
+      : kVertexCount(vertices.size()),
+        kEdgeCount(edges.size()),
+        vertices_(vertices) {
+    VType max_vertex = 0;
+    for (VType vertex : vertices) {
+      max_vertex = std::max(max_vertex, vertex);
+    }
+    for (auto edge : edges) {
+      max_vertex = std::max({max_vertex, edge.first, edge.second});
+    }
+    std::vector<size_t> offsets(static_cast<size_t>(max_vertex) + 2, 0);
+    for (auto edge : edges) {
+      ++offsets[edge.first];
+      if constexpr (!ordered) {
+        ++offsets[edge.second];
+      }
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<VType> arcs(offsets.back());
+    std::vector<size_t> arc_ids(offsets.back());
+    for (size_t i = edges.size(); i > 0; i--) {
+      const EType& edge = edges[i - 1];
+      if constexpr (!ordered) {
+        arcs[--offsets[edge.second]] = edge.first;
+        arc_ids[offsets[edge.second]] = ids[i - 1];
+      }
+      arcs[--offsets[edge.first]] = edge.second;
+      arc_ids[offsets[edge.first]] = ids[i - 1];
+    }
+    std::vector<size_t> entry(offsets.size(), 0);
+    std::vector<size_t> owner(offsets.size(), offsets.size());
+    offsets_.assign(offsets.size(), 0);
+    for (size_t vertex = 0; vertex + 1 < offsets.size(); vertex++) {
+      for (size_t arc = offsets[vertex]; arc < offsets[vertex + 1]; arc++) {
+        VType neighbour = arcs[arc];
+        if (owner[neighbour] != vertex) {
+          owner[neighbour] = vertex;
+          entry[neighbour] = neighbours_.size();
+          neighbours_.push_back(neighbour);
+          ids_.push_back(arc_ids[arc]);
+          multiplicities_.push_back(1);
+        } else {
+          ids_[entry[neighbour]] = arc_ids[arc];
+          ++multiplicities_[entry[neighbour]];
+        }
+      }
+      offsets_[vertex + 1] = neighbours_.size();
+    }
+  }
+  std::span<VType> GetNeighbors(const VType& vertex) override {
+    return {neighbours_.data() + offsets_[vertex],
+            neighbours_.data() + offsets_[vertex + 1]};
+  }
+  std::span<const size_t> GetEdgeIds(const VType& vertex) const {
+    return {ids_.data() + offsets_[vertex], ids_.data() + offsets_[vertex + 1]};
+  }
+  std::span<const size_t> GetMultiplicities(const VType& vertex) const {
+    return {multiplicities_.data() + offsets_[vertex],
+            multiplicities_.data() + offsets_[vertex + 1]};
+  }
+  size_t VertexCount() override { return kVertexCount; }
+  size_t EdgeCount() override { return kEdgeCount; }
+  const std::vector<VType>& Vertices() override { return vertices_; }
+  // NOLINTNEXTLINE
+  typename std::vector<VType>::iterator begin(const VType& vertex) override {
+    return neighbours_.begin() + offsets_[vertex];
+  }
+  // NOLINTNEXTLINE
+  typename std::vector<VType>::iterator end(const VType& vertex) override {
+    return neighbours_.begin() + offsets_[vertex + 1];
+  }
+  ~EdgeIdCSRListGraph() = default;
+
+ private:
+  std::vector<size_t> offsets_;
+  std::vector<VType> neighbours_;
+  std::vector<size_t> ids_;
+  std::vector<size_t> multiplicities_;
+  const size_t kVertexCount;
+  const size_t kEdgeCount;
+  std::vector<VType> vertices_;
+};
+
 template <class VType, class EType>
 class Visitor {
  public:
@@ -70,7 +388,7 @@ class Visitor {
 };
 
 template <class VType, class EType = std::pair<VType, VType>>
-class BridgesVisitor : public Visitor<VType, EType> {
+class BridgesVisitor final : public Visitor<VType, EType> {
  public:
   void Visit(const VType& vertex) override {
     time_in_[vertex] = time_++;
@@ -105,7 +423,7 @@ class BridgesVisitor : public Visitor<VType, EType> {
 };
 
 template <>
-class BridgesVisitor<int, std::pair<int, int>>
+class BridgesVisitor<int, std::pair<int, int>> final
     : public Visitor<int, std::pair<int, int>> {
  public:
   void Visit(const int& vertex) override {
@@ -144,33 +462,419 @@ class BridgesVisitor<int, std::pair<int, int>>
   int time_ = 0;
 };
 
-template <class VType, class EType>
-void BridgesDFS(VType& current, VType& parent, Graph<VType, EType>& graph,
-                Visitor<VType, EType>& visitor) {
-  visitor.Visit(current);
-  for (VType neighbour : graph.GetNeighbors(current)) {
-    if (parent != neighbour) {
-      if (!visitor.IsVisited(neighbour)) {
-        BridgesDFS(neighbour, current, graph, visitor);
-        visitor.Update(std::make_pair(current, neighbour));
-      } else {
-        visitor.Visit(std::make_pair(current, neighbour));
+template <class GraphType>
+concept NeighbourGraph =
+    requires(GraphType& graph, const typename GraphType::VertexType& vertex) {
+      { graph.GetNeighbors(vertex) } -> std::ranges::range;
+      { graph.Vertices() } -> std::ranges::range;
+      { graph.VertexCount() } -> std::convertible_to<size_t>;
+    };
+
+template <class VisitorType, class VType, class EType>
+concept LowLinkVisitor = requires(VisitorType& visitor, const VType& vertex,
+                                  const EType& edge) {
+  visitor.Visit(vertex);
+  visitor.Visit(edge);
+  visitor.Update(edge);
+  { visitor.IsVisited(vertex) } -> std::convertible_to<bool>;
+};
+
+// Hooks get IsVisited(v), Enter(v), TreeEdge(from, to) before descending,
+// BackEdge(from, to, parent) for edges to visited vertices (false stops the
+// traversal) and Exit(parent, child) once child is finished; the root is
+// its own parent.
+template <class VType, class Neighbours, class Hooks>
+bool IterativeDFS(VType root, Neighbours&& neighbours, Hooks& hooks) {
+  struct Frame {
+    VType vertex;
+    size_t next;
+  };
+  std::vector<Frame> stack;
+  hooks.Enter(root);
+  stack.push_back({root, 0});
+  while (!stack.empty()) {
+    VType current = stack.back().vertex;
+    auto&& adjacent = neighbours(current);
+    if (stack.back().next == adjacent.size()) {
+      stack.pop_back();
+      hooks.Exit(stack.empty() ? current : stack.back().vertex, current);
+      continue;
+    }
+    VType vertex = adjacent[stack.back().next++];
+    if (!hooks.IsVisited(vertex)) {
+      hooks.TreeEdge(current, vertex);
+      hooks.Enter(vertex);
+      stack.push_back({vertex, 0});
+    } else {
+      VType parent =
+          stack.size() > 1 ? stack[stack.size() - 2].vertex : current;
+      if (!hooks.BackEdge(current, vertex, parent)) {
+        return false;
       }
     }
   }
+  return true;
 }
 
-template <class VType, class EType>
-std::vector<EType> GetBridges(Graph<VType, EType>& graph) {
-  BridgesVisitor<VType, EType> visitor(graph.VertexCount());
+template <class VisitorType, class VType>
+class LowLinkHooks {
+ public:
+  explicit LowLinkHooks(VisitorType& visitor) : visitor_(visitor) {}
+  bool IsVisited(const VType& vertex) { return visitor_.IsVisited(vertex); }
+  void Enter(const VType& vertex) { visitor_.Visit(vertex); }
+  void TreeEdge(const VType& from, const VType& to) {}
+  bool BackEdge(const VType& from, const VType& to, const VType& parent) {
+    if (to != parent) {
+      visitor_.Visit(std::make_pair(from, to));
+    }
+    return true;
+  }
+  void Exit(const VType& parent, const VType& child) {
+    if (parent != child) {
+      visitor_.Update(std::make_pair(parent, child));
+    }
+  }
+
+ private:
+  VisitorType& visitor_;
+};
+
+template <NeighbourGraph GraphType, class VisitorType,
+          class VType = typename GraphType::VertexType>
+  requires LowLinkVisitor<VisitorType, VType, typename GraphType::EdgeType>
+void BridgesDFS(VType root, GraphType& graph, VisitorType& visitor) {
+  LowLinkHooks<VisitorType, VType> hooks(visitor);
+  IterativeDFS(
+      root,
+      [&graph](const VType& vertex) { return graph.GetNeighbors(vertex); },
+      hooks);
+}
+
+template <NeighbourGraph GraphType>
+std::vector<typename GraphType::EdgeType> GetBridges(GraphType& graph) {
+  using VType = typename GraphType::VertexType;
+  BridgesVisitor<VType, typename GraphType::EdgeType> visitor(
+      graph.VertexCount());
   for (VType vertex : graph.Vertices()) {
     if (!visitor.IsVisited(vertex)) {
-      BridgesDFS(vertex, vertex, graph, visitor);
+      BridgesDFS(vertex, graph, visitor);
     }
   }
   return visitor.GetBridges();
 }
 
+template <class GraphType>
+size_t IdBound(GraphType& graph) {
+  size_t id_bound = 0;
+  for (auto vertex : graph.Vertices()) {
+    id_bound = std::max(id_bound, static_cast<size_t>(vertex) + 1);
+  }
+  return id_bound;
+}
+
+template <class Function>
+void ParallelFor(size_t count, size_t thread_count, Function&& function) {
+  static constexpr size_t kChunk = 1024;
+  thread_count = std::max<size_t>(thread_count, 1);
+  std::atomic<size_t> cursor = 0;
+  auto worker = [&]() {
+    for (size_t begin = cursor.fetch_add(kChunk); begin < count;
+         begin = cursor.fetch_add(kChunk)) {
+      size_t end = std::min(begin + kChunk, count);
+      for (size_t i = begin; i < end; i++) {
+        function(i);
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t id = 1; id < thread_count; id++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void ParallelPrefixSum(std::vector<size_t>& values, size_t thread_count) {
+  static constexpr size_t kBlock = 1 << 16;
+  size_t block_count = (values.size() + kBlock - 1) / kBlock;
+  std::vector<size_t> totals(block_count + 1, 0);
+  ParallelFor(block_count, thread_count, [&](size_t block) {
+    size_t begin = block * kBlock;
+    size_t end = std::min(begin + kBlock, values.size());
+    std::partial_sum(values.begin() + begin, values.begin() + end,
+                     values.begin() + begin);
+    totals[block + 1] = values[end - 1];
+  });
+  std::partial_sum(totals.begin(), totals.end(), totals.begin());
+  ParallelFor(block_count, thread_count, [&](size_t block) {
+    size_t end = std::min((block + 1) * kBlock, values.size());
+    for (size_t i = block * kBlock; i < end; i++) {
+      values[i] += totals[block];
+    }
+  });
+}
+
+// Concurrent union-find over dense ids where every root is the smallest id of
+// its tree; Link returns true iff it merged two trees, so the edges it
+// accepts form a spanning forest.
+class ConcurrentLabels {
+ public:
+  explicit ConcurrentLabels(size_t size) : parent_(size) {
+    for (size_t i = 0; i < size; i++) {
+      parent_[i].store(i, std::memory_order_relaxed);
+    }
+  }
+  size_t Get(size_t index) const {
+    return parent_[index].load(std::memory_order_relaxed);
+  }
+  bool Link(size_t first, size_t second) {
+    size_t first_parent = Get(first);
+    size_t second_parent = Get(Get(second));
+    while (first_parent != second_parent) {
+      size_t high = std::max(first_parent, second_parent);
+      size_t low = std::min(first_parent, second_parent);
+      size_t high_parent = Get(high);
+      if (high_parent == low) {
+        return false;
+      }
+      if (high_parent == high &&
+          parent_[high].compare_exchange_strong(high_parent, low)) {
+        return true;
+      }
+      first_parent = Get(Get(high));
+      second_parent = Get(low);
+    }
+    return false;
+  }
+
+ private:
+  std::vector<std::atomic<size_t>> parent_;
+};
+
+// Tarjan-Vishkin: a spanning forest from concurrent union-find, its Euler
+// tour ranked by pointer jumping, preorder numbers and subtree sizes from a
+// prefix sum over the tour, and subtree low/high from sparse tables. A tree
+// edge parent-v is a bridge iff no edge leaves the preorder interval of v.
+// Like GetBridges, edges parallel to a tree edge are ignored. GetNeighbors
+// must be safe to call concurrently, which holds for CSRListGraph.
+template <NeighbourGraph GraphType>
+std::vector<typename GraphType::EdgeType> ParallelBridges(
+    GraphType& graph,
+    size_t thread_count = std::thread::hardware_concurrency()) {
+  using VType = typename GraphType::VertexType;
+  static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+  const std::vector<VType>& vertices = graph.Vertices();
+  size_t id_bound = IdBound(graph);
+  ConcurrentLabels labels(id_bound);
+  std::vector<std::pair<size_t, size_t>> tree(id_bound);
+  std::atomic<size_t> tree_size = 0;
+  ParallelFor(vertices.size(), thread_count, [&](size_t i) {
+    for (VType vertex : graph.GetNeighbors(vertices[i])) {
+      if (labels.Link(vertices[i], vertex)) {
+        tree[tree_size.fetch_add(1, std::memory_order_relaxed)] = {
+            vertices[i], vertex};
+      }
+    }
+  });
+  size_t tree_count = tree_size.load();
+  size_t arc_count = 2 * tree_count;
+  if (tree_count == 0) {
+    return {};
+  }
+  std::vector<std::atomic<size_t>> degree(id_bound + 1);
+  ParallelFor(tree_count, thread_count, [&](size_t i) {
+    degree[tree[i].first + 1].fetch_add(1, std::memory_order_relaxed);
+    degree[tree[i].second + 1].fetch_add(1, std::memory_order_relaxed);
+  });
+  std::vector<size_t> offsets(id_bound + 1);
+  for (size_t i = 0; i <= id_bound; i++) {
+    offsets[i] = degree[i].exchange(0, std::memory_order_relaxed);
+  }
+  ParallelPrefixSum(offsets, thread_count);
+  std::vector<size_t> target(arc_count);
+  std::vector<size_t> twin(arc_count);
+  ParallelFor(tree_count, thread_count, [&](size_t i) {
+    auto [first, second] = tree[i];
+    size_t forward =
+        offsets[first] + degree[first].fetch_add(1, std::memory_order_relaxed);
+    size_t backward = offsets[second] +
+                      degree[second].fetch_add(1, std::memory_order_relaxed);
+    target[forward] = second;
+    target[backward] = first;
+    twin[forward] = backward;
+    twin[backward] = forward;
+  });
+  std::vector<size_t> next(arc_count);
+  ParallelFor(arc_count, thread_count, [&](size_t arc) {
+    size_t vertex = target[arc];
+    size_t begin = offsets[vertex];
+    size_t size = offsets[vertex + 1] - begin;
+    next[arc] = begin + (twin[arc] - begin + 1) % size;
+  });
+  std::vector<uint8_t> first_arc(arc_count, 0);
+  size_t last = kNone;
+  for (size_t vertex = 0; vertex < id_bound; vertex++) {
+    if (labels.Get(vertex) == vertex && offsets[vertex + 1] > offsets[vertex]) {
+      first_arc[offsets[vertex]] = 1;
+      if (last != kNone) {
+        next[last] = offsets[vertex];
+      }
+      last = twin[offsets[vertex + 1] - 1];
+    }
+  }
+  next[last] = kNone;
+  std::vector<size_t> rank(arc_count);
+  std::vector<size_t> jump = next;
+  ParallelFor(arc_count, thread_count,
+              [&](size_t arc) { rank[arc] = next[arc] == kNone ? 0 : 1; });
+  std::vector<size_t> next_rank(arc_count);
+  std::vector<size_t> next_jump(arc_count);
+  for (size_t step = 1; step < arc_count; step *= 2) {
+    ParallelFor(arc_count, thread_count, [&](size_t arc) {
+      size_t ahead = jump[arc];
+      next_rank[arc] = rank[arc] + (ahead == kNone ? 0 : rank[ahead]);
+      next_jump[arc] = ahead == kNone ? kNone : jump[ahead];
+    });
+    std::swap(rank, next_rank);
+    std::swap(jump, next_jump);
+  }
+  std::vector<size_t>& position = rank;
+  std::vector<size_t> tour(arc_count);
+  std::vector<size_t> weight(arc_count);
+  ParallelFor(arc_count, thread_count, [&](size_t arc) {
+    position[arc] = arc_count - 1 - position[arc];
+  });
+  ParallelFor(arc_count, thread_count, [&](size_t arc) {
+    tour[position[arc]] = arc;
+    weight[position[arc]] =
+        static_cast<size_t>(position[arc] < position[twin[arc]]) +
+        first_arc[arc];
+  });
+  ParallelPrefixSum(weight, thread_count);
+  std::vector<size_t> preorder(id_bound, kNone);
+  std::vector<size_t> parent(id_bound, kNone);
+  std::vector<size_t> subtree(id_bound, 0);
+  ParallelFor(arc_count, thread_count, [&](size_t index) {
+    size_t arc = tour[index];
+    if (index > position[twin[arc]]) {
+      return;
+    }
+    size_t vertex = target[arc];
+    preorder[vertex] = weight[index] - 1;
+    parent[vertex] = target[twin[arc]];
+    subtree[vertex] = (position[twin[arc]] - index + 1) / 2;
+    if (first_arc[arc] != 0) {
+      preorder[target[twin[arc]]] = weight[index] - 2;
+    }
+  });
+  size_t numbered = weight.back();
+  std::vector<std::vector<size_t>> low(1, std::vector<size_t>(numbered));
+  std::vector<std::vector<size_t>> high(1, std::vector<size_t>(numbered));
+  ParallelFor(vertices.size(), thread_count, [&](size_t i) {
+    size_t vertex = vertices[i];
+    if (preorder[vertex] == kNone) {
+      return;
+    }
+    size_t lowest = preorder[vertex];
+    size_t highest = preorder[vertex];
+    for (VType neighbour : graph.GetNeighbors(vertices[i])) {
+      if (static_cast<size_t>(neighbour) != parent[vertex]) {
+        lowest = std::min(lowest, preorder[neighbour]);
+        highest = std::max(highest, preorder[neighbour]);
+      }
+    }
+    low[0][preorder[vertex]] = lowest;
+    high[0][preorder[vertex]] = highest;
+  });
+  for (size_t width = 1; 2 * width <= numbered; width *= 2) {
+    low.emplace_back(numbered - 2 * width + 1);
+    high.emplace_back(numbered - 2 * width + 1);
+    std::vector<size_t>& low_level = low.back();
+    std::vector<size_t>& high_level = high.back();
+    const std::vector<size_t>& low_below = low[low.size() - 2];
+    const std::vector<size_t>& high_below = high[high.size() - 2];
+    ParallelFor(low_level.size(), thread_count, [&](size_t i) {
+      low_level[i] = std::min(low_below[i], low_below[i + width]);
+      high_level[i] = std::max(high_below[i], high_below[i + width]);
+    });
+  }
+  std::vector<uint8_t> bridge(id_bound, 0);
+  ParallelFor(vertices.size(), thread_count, [&](size_t i) {
+    size_t vertex = vertices[i];
+    if (parent[vertex] == kNone) {
+      return;
+    }
+    size_t begin = preorder[vertex];
+    size_t end = begin + subtree[vertex];
+    size_t level = std::bit_width(subtree[vertex]) - 1;
+    size_t right = end - (size_t{1} << level);
+    bridge[vertex] =
+        std::min(low[level][begin], low[level][right]) >= begin &&
+        std::max(high[level][begin], high[level][right]) < end;
+  });
+  std::vector<typename GraphType::EdgeType> bridges;
+  for (VType vertex : vertices) {
+    if (bridge[vertex] != 0) {
+      bridges.emplace_back(static_cast<VType>(parent[vertex]), vertex);
+    }
+  }
+  return bridges;
+}
+
+// IterativeDFS reports every adjacency entry exactly once and in order, so a
+// per-vertex cursor recovers the position of each tree edge.
+template <class VisitorType, class VType>
+class ArcHooks {
+ public:
+  ArcHooks(VisitorType& visitor, size_t id_bound)
+      : low_link_(visitor), cursor_(id_bound, 0), position_(id_bound, 0) {}
+  bool IsVisited(const VType& vertex) { return low_link_.IsVisited(vertex); }
+  void Enter(const VType& vertex) { low_link_.Enter(vertex); }
+  void TreeEdge(const VType& from, const VType& to) {
+    position_[to] = cursor_[from]++;
+    low_link_.TreeEdge(from, to);
+  }
+  bool BackEdge(const VType& from, const VType& to, const VType& parent) {
+    ++cursor_[from];
+    return low_link_.BackEdge(from, to, parent);
+  }
+  void Exit(const VType& parent, const VType& child) {
+    low_link_.Exit(parent, child);
+  }
+  size_t Position(const VType& child) const { return position_[child]; }
+
+ private:
+  LowLinkHooks<VisitorType, VType> low_link_;
+  std::vector<size_t> cursor_;
+  std::vector<size_t> position_;
+};
+
+// Every bridge parent-child comes with the position of child in the
+// adjacency of parent.
+template <NeighbourGraph GraphType>
+std::vector<std::pair<typename GraphType::EdgeType, size_t>> GetBridgeArcs(
+    GraphType& graph) {
+  using VType = typename GraphType::VertexType;
+  using VisitorType = BridgesVisitor<VType, typename GraphType::EdgeType>;
+  VisitorType visitor(graph.VertexCount());
+  ArcHooks<VisitorType, VType> hooks(visitor, IdBound(graph));
+  for (VType root : graph.Vertices()) {
+    if (!visitor.IsVisited(root)) {
+      IterativeDFS(
+          root,
+          [&graph](const VType& vertex) { return graph.GetNeighbors(vertex); },
+          hooks);
+    }
+  }
+  std::vector<std::pair<typename GraphType::EdgeType, size_t>> result;
+  for (auto edge : visitor.GetBridges()) {
+    result.emplace_back(edge, hooks.Position(edge.second));
+  }
+  return result;
+}
+
 struct State {
   std::vector<int> result;
   std::vector<bool> used;
@@ -181,15 +885,13 @@ struct State {
         count(0) {}
 };
 
-template <class VType, class EType>
-int GetNeed(
-    Graph<VType, EType>& graph,
-    std::unordered_map<int, std::unordered_map<int, std::pair<int, int>>>& dict,
-    std::set<int>& avoid, std::vector<std::pair<int, int>>& edges) {
+template <class GraphType, class VType = typename GraphType::VertexType>
+int GetNeed(GraphType& graph, std::set<int>& avoid,
+            std::vector<std::pair<int, int>>& edges) {
   State state(graph.VertexCount());
   for (VType vertex : graph.Vertices()) {
     if (!state.used[vertex]) {
-      DFS(graph, state, vertex, dict, avoid);
+      DFS(graph, state, vertex, avoid);
       state.count++;
     }
   }
@@ -209,53 +911,49 @@ int GetNeed(
   return (full_count / 2) + (full_count % 2);
 }
 
-template <class VType, class EType>
-void DFS(
-    Graph<VType, EType>& graph, State& state, VType current,
-    std::unordered_map<int, std::unordered_map<int, std::pair<int, int>>>& dict,
-    std::set<int>& avoid) {
+template <class GraphType, class VType>
+void DFS(GraphType& graph, State& state, VType current, std::set<int>& avoid) {
   state.result[current] = state.count;
   state.used[current] = true;
-  for (VType vertex : graph.GetNeighbors(current)) {
-    if (!state.used[vertex]) {
-      if (avoid.find(dict[current][vertex].first) == avoid.end()) {
-        DFS(graph, state, vertex, dict, avoid);
+  std::span<VType> neighbours = graph.GetNeighbors(current);
+  std::span<const size_t> ids = graph.GetEdgeIds(current);
+  for (size_t i = 0; i < neighbours.size(); i++) {
+    if (!state.used[neighbours[i]]) {
+      if (avoid.find(static_cast<int>(ids[i])) == avoid.end()) {
+        DFS(graph, state, neighbours[i], avoid);
       }
     }
   }
 }
 
 int main() {
+  FastInput input;
+  FastOutput output;
   int vertex_count;
   int edge_count;
-  std::cin >> vertex_count >> edge_count;
+  input >> vertex_count >> edge_count;
   std::vector<int> vertices(vertex_count);
   std::iota(vertices.begin(), vertices.end(), 0);
   std::vector<std::pair<int, int>> edges;
-  std::unordered_map<int, std::unordered_map<int, std::pair<int, int>>> dict;
+  std::vector<size_t> ids;
   for (int i = 1; i <= edge_count; i++) {
     int first;
     int second;
-    std::cin >> first >> second;
+    input >> first >> second;
     first--;
     second--;
     if (first != second) {
+      ids.push_back(edges.size());
       edges.emplace_back(first, second);
     }
-    dict[first][second].first = i - 1;
-    dict[second][first].first = i - 1;
-    dict[first][second].second++;
-    dict[second][first].second++;
   }
-  ListGraph<int> graph(vertices, edges);
-  std::vector<std::pair<int, int>> bridges = GetBridges(graph);
-  std::vector<int> result;
+  EdgeIdCSRListGraph<int> graph(vertices, edges, ids);
   std::set<int> set;
-  for (auto edge : bridges) {
-    if (dict[edge.first][edge.second].second == 1) {
-      set.insert(dict[edge.first][edge.second].first);
+  for (auto [edge, position] : GetBridgeArcs(graph)) {
+    if (graph.GetMultiplicities(edge.first)[position] == 1) {
+      set.insert(static_cast<int>(graph.GetEdgeIds(edge.first)[position]));
     }
   }
-  std::cout << GetNeed(graph, dict, set, edges);
+  output << GetNeed(graph, set, edges);
   return 0;
 }
\ No newline at end of file
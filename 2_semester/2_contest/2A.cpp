@@ -1,16 +1,524 @@
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 #include <algorithm>
-#include <iostream>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <numbers>
+#include <numeric>
 #include <queue>
+#include <random>
 #include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
-std::vector<int> Dijkstra(
-    std::vector<std::vector<std::pair<size_t, int>>>& edges,
-    size_t vertex_count, size_t start) {
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
+// A binary graph record is a BinaryGraphHeader followed by the CSR arrays
+// offsets[id_bound + 1] and neighbours[arc_count], then weights[arc_count]
+// if kWeighted and, if kEdgeIds, the index of the input edge behind every
+// arc. Every field is a native-endian 64-bit word, so a mapped file is used
+// in place; records may follow each other in one file.
+struct BinaryGraphHeader {
+  static constexpr uint64_t kMagic = 0x3152534348505247;  // "GRPHCSR1"
+  static constexpr uint32_t kUndirected = 1;
+  static constexpr uint32_t kWeighted = 2;
+  static constexpr uint32_t kEdgeIds = 4;
+
+  uint64_t magic = kMagic;
+  uint32_t flags = 0;
+  uint32_t reserved = 0;
+  uint64_t vertex_count = 0;
+  uint64_t id_bound = 0;
+  uint64_t edge_count = 0;
+  uint64_t arc_count = 0;
+  uint64_t source = 0;
+  uint64_t sink = 0;
+};
+
+class BinaryGraph {
+ public:
+  explicit BinaryGraph(std::span<const std::byte> data) {
+    if (data.size() < sizeof(BinaryGraphHeader)) {
+      throw std::runtime_error("truncated graph header");
+    }
+    header_ = reinterpret_cast<const BinaryGraphHeader*>(data.data());
+    if (header_->magic != BinaryGraphHeader::kMagic) {
+      throw std::runtime_error("not a binary graph");
+    }
+    const auto* words = reinterpret_cast<const uint64_t*>(header_ + 1);
+    size_t arcs = header_->arc_count;
+    offsets_ = {words, header_->id_bound + 1};
+    words += offsets_.size();
+    neighbours_ = {words, arcs};
+    words += arcs;
+    if (header_->flags & BinaryGraphHeader::kWeighted) {
+      weights_ = {reinterpret_cast<const int64_t*>(words), arcs};
+      words += arcs;
+    }
+    if (header_->flags & BinaryGraphHeader::kEdgeIds) {
+      edge_ids_ = {words, arcs};
+      words += arcs;
+    }
+    byte_size_ = reinterpret_cast<const std::byte*>(words) - data.data();
+    if (byte_size_ > data.size()) {
+      throw std::runtime_error("truncated graph");
+    }
+  }
+  const BinaryGraphHeader& Header() const { return *header_; }
+  std::span<const uint64_t> Offsets() const { return offsets_; }
+  std::span<const uint64_t> Neighbours() const { return neighbours_; }
+  std::span<const int64_t> Weights() const { return weights_; }
+  std::span<const uint64_t> EdgeIds() const { return edge_ids_; }
+  // The next record, if any, starts this many bytes after the header.
+  size_t ByteSize() const { return byte_size_; }
+
+ private:
+  const BinaryGraphHeader* header_;
+  std::span<const uint64_t> offsets_;
+  std::span<const uint64_t> neighbours_;
+  std::span<const int64_t> weights_;
+  std::span<const uint64_t> edge_ids_;
+  size_t byte_size_;
+};
+
+class MappedFile {
+ public:
+  explicit MappedFile(const char* path) {
+    int descriptor = open(path, O_RDONLY);
+    if (descriptor < 0) {
+      throw std::system_error(errno, std::generic_category(), path);
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0) {
+      int error = errno;
+      close(descriptor);
+      throw std::system_error(error, std::generic_category(), path);
+    }
+    size_ = status.st_size;
+    if (size_ > 0) {
+      data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    }
+    int error = errno;
+    close(descriptor);
+    if (data_ == MAP_FAILED) {
+      throw std::system_error(error, std::generic_category(), path);
+    }
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile() {
+    if (size_ > 0) {
+      munmap(data_, size_);
+    }
+  }
+  std::span<const std::byte> Bytes() const {
+    return {static_cast<const std::byte*>(data_), size_};
+  }
+
+ private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Arcs of a vertex keep the input order of their edges, as CSRListGraph
+// lays them out; weights may be empty unless kWeighted is set.
+void WriteBinaryGraph(std::ostream& output, BinaryGraphHeader header,
+                      const std::vector<std::pair<uint64_t, uint64_t>>& edges,
+                      const std::vector<int64_t>& weights) {
+  bool undirected = header.flags & BinaryGraphHeader::kUndirected;
+  std::vector<uint64_t> offsets(header.id_bound + 1, 0);
+  for (auto edge : edges) {
+    ++offsets[edge.first + 1];
+    if (undirected) {
+      ++offsets[edge.second + 1];
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  header.edge_count = edges.size();
+  header.arc_count = offsets.back();
+  std::vector<uint64_t> neighbours(header.arc_count);
+  std::vector<int64_t> arc_weights(header.arc_count);
+  std::vector<uint64_t> edge_ids(header.arc_count);
+  std::vector<uint64_t> fill(offsets.begin() + 1, offsets.end());
+  auto place = [&](uint64_t from, uint64_t to, size_t index) {
+    size_t arc = --fill[from];
+    neighbours[arc] = to;
+    arc_weights[arc] = weights.empty() ? 0 : weights[index];
+    edge_ids[arc] = index;
+  };
+  for (size_t i = edges.size(); i > 0; i--) {
+    if (undirected) {
+      place(edges[i - 1].second, edges[i - 1].first, i - 1);
+    }
+    place(edges[i - 1].first, edges[i - 1].second, i - 1);
+  }
+  auto write = [&output](const void* data, size_t size) {
+    output.write(static_cast<const char*>(data),
+                 static_cast<std::streamsize>(size));
+  };
+  write(&header, sizeof(header));
+  write(offsets.data(), offsets.size() * sizeof(uint64_t));
+  write(neighbours.data(), neighbours.size() * sizeof(uint64_t));
+  if (header.flags & BinaryGraphHeader::kWeighted) {
+    write(arc_weights.data(), arc_weights.size() * sizeof(int64_t));
+  }
+  if (header.flags & BinaryGraphHeader::kEdgeIds) {
+    write(edge_ids.data(), edge_ids.size() * sizeof(uint64_t));
+  }
+  if (!output) {
+    throw std::runtime_error("failed to write graph");
+  }
+}
+
+// Indexes like the nested adjacency vectors: graph[vertex] yields the
+// (neighbour, weight) pairs of a weighted record, read from the mapping.
+class MappedAdjacency {
+ public:
+  class Arcs {
+   public:
+    class Iterator {
+     public:
+      Iterator(const uint64_t* neighbour, const int64_t* weight)
+          : neighbour_(neighbour), weight_(weight) {}
+      std::pair<size_t, int64_t> operator*() const {
+        return {*neighbour_, *weight_};
+      }
+      Iterator& operator++() {
+        ++neighbour_;
+        ++weight_;
+        return *this;
+      }
+      bool operator!=(const Iterator& other) const {
+        return neighbour_ != other.neighbour_;
+      }
+
+     private:
+      const uint64_t* neighbour_;
+      const int64_t* weight_;
+    };
+
+    Arcs(const uint64_t* neighbours, const int64_t* weights, size_t size)
+        : neighbours_(neighbours), weights_(weights), size_(size) {}
+    Iterator begin() const { return {neighbours_, weights_}; }
+    Iterator end() const { return {neighbours_ + size_, weights_ + size_}; }
+
+   private:
+    const uint64_t* neighbours_;
+    const int64_t* weights_;
+    size_t size_;
+  };
+
+  explicit MappedAdjacency(const BinaryGraph& graph)
+      : offsets_(graph.Offsets()),
+        neighbours_(graph.Neighbours()),
+        weights_(graph.Weights()) {}
+  Arcs operator[](size_t vertex) const {
+    return {neighbours_.data() + offsets_[vertex],
+            weights_.data() + offsets_[vertex],
+            offsets_[vertex + 1] - offsets_[vertex]};
+  }
+
+ private:
+  std::span<const uint64_t> offsets_;
+  std::span<const uint64_t> neighbours_;
+  std::span<const int64_t> weights_;
+};
+
+// Appends value as a base-128 varint: seven bits per byte, low bits first,
+// with the high bit set on every byte but the last.
+void PutVarint(std::vector<uint8_t>& bytes, uint64_t value) {
+  while (value >= 0x80) {
+    bytes.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  bytes.push_back(static_cast<uint8_t>(value));
+}
+
+inline uint64_t GetVarint(const uint8_t*& cursor) {
+  uint64_t value = *cursor++;
+  if (value < 0x80) {
+    return value;
+  }
+  value &= 0x7f;
+  for (unsigned shift = 7;; shift += 7) {
+    uint64_t byte = *cursor++;
+    value |= (byte & 0x7f) << shift;
+    if (byte < 0x80) {
+      return value;
+    }
+  }
+}
+
+// Adjacency lists sorted and gap encoded as varints: every arc is its
+// neighbour, as the zigzagged difference from the vertex for the first arc
+// and the difference from the previous neighbour after that, then its
+// zigzagged weight. graph[vertex] decodes the (neighbour, weight) pairs on
+// the fly in increasing order.
+class CompressedAdjacency {
+ public:
+  class Arcs {
+   public:
+    class Iterator {
+     public:
+      using value_type = std::pair<size_t, int64_t>;
+      using difference_type = std::ptrdiff_t;
+
+      Iterator() = default;
+      Iterator(const uint8_t* cursor, const uint8_t* end, size_t vertex)
+          : cursor_(cursor), next_(cursor), end_(end) {
+        if (cursor_ != end_) {
+          arc_.first = vertex + Unzigzag(GetVarint(next_));
+          arc_.second = static_cast<int64_t>(Unzigzag(GetVarint(next_)));
+        }
+      }
+      std::pair<size_t, int64_t> operator*() const { return arc_; }
+      Iterator& operator++() {
+        cursor_ = next_;
+        if (cursor_ != end_) {
+          arc_.first += GetVarint(next_);
+          arc_.second = static_cast<int64_t>(Unzigzag(GetVarint(next_)));
+        }
+        return *this;
+      }
+      Iterator operator++(int) {
+        Iterator previous = *this;
+        ++*this;
+        return previous;
+      }
+      bool operator==(const Iterator& other) const {
+        return cursor_ == other.cursor_;
+      }
+
+     private:
+      static uint64_t Unzigzag(uint64_t value) {
+        return (value >> 1) ^ (0 - (value & 1));
+      }
+
+      const uint8_t* cursor_ = nullptr;
+      const uint8_t* next_ = nullptr;
+      const uint8_t* end_ = nullptr;
+      std::pair<size_t, int64_t> arc_;
+    };
+
+    Arcs(const uint8_t* begin, const uint8_t* end, size_t vertex)
+        : begin_(begin), end_(end), vertex_(vertex) {}
+    Iterator begin() const { return {begin_, end_, vertex_}; }
+    Iterator end() const { return {end_, end_, vertex_}; }
+
+   private:
+    const uint8_t* begin_;
+    const uint8_t* end_;
+    size_t vertex_;
+  };
+
+  template <std::unsigned_integral Index>
+  explicit CompressedAdjacency(
+      const std::vector<std::vector<std::pair<Index, int>>>& edges)
+      : offsets_(edges.size() + 1, 0) {
+    auto zigzag = [](uint64_t value) {
+      return (value << 1) ^ (0 - (value >> 63));
+    };
+    std::vector<std::pair<Index, int>> sorted;
+    for (size_t vertex = 0; vertex < edges.size(); vertex++) {
+      sorted.assign(edges[vertex].begin(), edges[vertex].end());
+      std::sort(sorted.begin(), sorted.end());
+      size_t previous = vertex;
+      for (size_t i = 0; i < sorted.size(); i++) {
+        uint64_t gap = sorted[i].first - previous;
+        PutVarint(bytes_, i == 0 ? zigzag(gap) : gap);
+        PutVarint(bytes_, zigzag(static_cast<int64_t>(sorted[i].second)));
+        previous = sorted[i].first;
+      }
+      offsets_[vertex + 1] = bytes_.size();
+    }
+    bytes_.shrink_to_fit();
+  }
+  Arcs operator[](size_t vertex) const {
+    return {bytes_.data() + offsets_[vertex],
+            bytes_.data() + offsets_[vertex + 1], vertex};
+  }
+  size_t ByteSize() const {
+    return offsets_.size() * sizeof(uint64_t) + bytes_.size();
+  }
+
+ private:
+  std::vector<uint64_t> offsets_;
+  std::vector<uint8_t> bytes_;
+};
+
+// The queue keeps vertex ids in the type of start.
+template <class Adjacency, std::unsigned_integral Index>
+std::vector<int> Dijkstra(Adjacency& edges, size_t vertex_count,
+                          Index start) {
   std::vector<int> results(vertex_count, 2009000999);
-  std::priority_queue<std::pair<int, size_t>,
-                      std::vector<std::pair<int, size_t>>, std::greater<>>
+  std::priority_queue<std::pair<int, Index>,
+                      std::vector<std::pair<int, Index>>, std::greater<>>
       queue;
   queue.push({0, start});
   results[start] = 0;
@@ -30,33 +538,424 @@ std::vector<int> Dijkstra(
   return results;
 }
 
-int main() {
-  std::ios_base::sync_with_stdio(false);
-  std::cin.tie(nullptr);
-  std::cout.tie(nullptr);
+// Reverse Cuthill-McKee over the arcs of an adjacency: every component is
+// walked breadth first from a vertex of least degree with neighbours taken
+// by increasing degree, and the walk is reversed. Returns the new id of
+// every vertex.
+template <std::unsigned_integral Index>
+std::vector<Index> ReverseCuthillMcKee(
+    const std::vector<std::vector<std::pair<Index, int>>>& edges) {
+  size_t vertex_count = edges.size();
+  auto by_degree = [&edges](size_t first, size_t second) {
+    return edges[first].size() < edges[second].size();
+  };
+  std::vector<Index> roots(vertex_count);
+  std::iota(roots.begin(), roots.end(), Index{0});
+  std::stable_sort(roots.begin(), roots.end(), by_degree);
+  std::vector<Index> order;
+  order.reserve(vertex_count);
+  std::vector<bool> placed(vertex_count, false);
+  for (Index root : roots) {
+    if (placed[root]) {
+      continue;
+    }
+    placed[root] = true;
+    order.push_back(root);
+    for (size_t head = order.size() - 1; head < order.size(); head++) {
+      size_t begin = order.size();
+      for (auto edge : edges[order[head]]) {
+        if (!placed[edge.first]) {
+          placed[edge.first] = true;
+          order.push_back(edge.first);
+        }
+      }
+      std::stable_sort(order.begin() + begin, order.end(), by_degree);
+    }
+  }
+  std::vector<Index> new_ids(vertex_count);
+  for (size_t i = 0; i < vertex_count; i++) {
+    new_ids[order[vertex_count - 1 - i]] = static_cast<Index>(i);
+  }
+  return new_ids;
+}
+
+// Moves every vertex to its new id; adjacency lists keep their order.
+template <std::unsigned_integral Index>
+std::vector<std::vector<std::pair<Index, int>>> Relabel(
+    const std::vector<std::vector<std::pair<Index, int>>>& edges,
+    const std::vector<Index>& new_ids) {
+  std::vector<std::vector<std::pair<Index, int>>> result(edges.size());
+  for (size_t vertex = 0; vertex < edges.size(); vertex++) {
+    std::vector<std::pair<Index, int>>& arcs = result[new_ids[vertex]];
+    arcs.reserve(edges[vertex].size());
+    for (auto edge : edges[vertex]) {
+      arcs.emplace_back(new_ids[edge.first], edge.second);
+    }
+  }
+  return result;
+}
+
+// Dijkstra on the RCM relabeling, with distances mapped back to the
+// original ids.
+template <std::unsigned_integral Index>
+std::vector<int> ReorderedDijkstra(
+    std::vector<std::vector<std::pair<Index, int>>>& edges,
+    size_t vertex_count, Index start) {
+  std::vector<Index> new_ids = ReverseCuthillMcKee(edges);
+  std::vector<std::vector<std::pair<Index, int>>> reordered =
+      Relabel(edges, new_ids);
+  std::vector<int> distances =
+      Dijkstra(reordered, vertex_count, new_ids[start]);
+  std::vector<int> results(vertex_count);
+  for (size_t vertex = 0; vertex < vertex_count; vertex++) {
+    results[vertex] = distances[new_ids[vertex]];
+  }
+  return results;
+}
+
+// Counts the hardware cache misses of the calling thread between Start and
+// Stop through perf_event_open; Misses() is -1 where the kernel or the
+// machine does not expose the counter.
+class CacheMissCounter {
+ public:
+  CacheMissCounter() {
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    descriptor_ = static_cast<int>(
+        syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+  }
+  CacheMissCounter(const CacheMissCounter&) = delete;
+  CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+  ~CacheMissCounter() {
+    if (descriptor_ >= 0) {
+      close(descriptor_);
+    }
+  }
+  void Start() {
+    if (descriptor_ >= 0) {
+      ioctl(descriptor_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(descriptor_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+  void Stop() {
+    if (descriptor_ >= 0) {
+      ioctl(descriptor_, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  int64_t Misses() const {
+    uint64_t count = 0;
+    if (descriptor_ < 0 ||
+        read(descriptor_, &count, sizeof(count)) != sizeof(count)) {
+      return -1;
+    }
+    return static_cast<int64_t>(count);
+  }
+
+ private:
+  int descriptor_;
+};
+
+// Runs kernel once and prints its wall time and cache misses as one JSON
+// object per line.
+template <class Kernel>
+void ReportKernel(std::string_view name, std::string_view order,
+                  Kernel&& kernel, FastOutput& output) {
+  CacheMissCounter counter;
+  auto begin = std::chrono::steady_clock::now();
+  counter.Start();
+  kernel();
+  counter.Stop();
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  output << "{\"kernel\": \"" << name << "\", \"order\": \"" << order
+         << "\", \"microseconds\": "
+         << std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+                .count()
+         << ", \"cache_misses\": " << counter.Misses() << "}\n";
+}
+
+// Prints the bytes an adjacency layout takes as one JSON object per line.
+void ReportBytes(std::string_view layout, size_t bytes, FastOutput& output) {
+  output << "{\"layout\": \"" << layout << "\", \"bytes\": " << bytes
+         << "}\n";
+}
+
+// Heap bytes held by nested adjacency vectors, allocator overhead aside.
+template <class T>
+size_t NestedBytes(const std::vector<std::vector<T>>& lists) {
+  size_t bytes = lists.capacity() * sizeof(std::vector<T>);
+  for (const std::vector<T>& list : lists) {
+    bytes += list.capacity() * sizeof(T);
+  }
+  return bytes;
+}
+
+// Runs kernel once on a synthetic input and prints its throughput as one
+// JSON object per line; count is the number of units the kernel processed.
+template <class Kernel>
+void ReportThroughput(std::string_view name, std::string_view generator,
+                      size_t size, std::string_view unit, size_t count,
+                      Kernel&& kernel, FastOutput& output) {
+  auto begin = std::chrono::steady_clock::now();
+  kernel();
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  uint64_t microseconds = std::max<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(),
+      1);
+  output << "{\"kernel\": \"" << name << "\", \"generator\": \"" << generator
+         << "\", \"size\": " << size << ", \"" << unit << "\": " << count
+         << ", \"microseconds\": " << microseconds << ", \"" << unit
+         << "_per_second\": " << count * 1000000 / microseconds << "}\n";
+}
+
+// Deterministic synthetic graphs for the benchmarks: the same generator,
+// vertex count and seed always give the same edges over [0, vertex_count).
+// "rmat" is a power-law R-MAT graph and "geometric" joins random points of
+// the unit square that are close enough for about eight neighbours each;
+// "grid" is the largest square 4-neighbour grid that fits and "path" one
+// long path.
+std::vector<std::pair<size_t, size_t>> SyntheticEdges(
+    std::string_view generator, size_t vertex_count, uint64_t seed = 1) {
+  static constexpr size_t kDegree = 8;
+  std::mt19937_64 random(seed);
+  auto unit = [&random]() {
+    return static_cast<double>(random() >> 11) * 0x1p-53;
+  };
+  std::vector<std::pair<size_t, size_t>> edges;
+  if (generator == "rmat") {
+    size_t scale = std::bit_width(std::max<size_t>(vertex_count, 2) - 1);
+    edges.reserve(vertex_count * kDegree / 2);
+    while (edges.size() < vertex_count * kDegree / 2) {
+      size_t from = 0;
+      size_t to = 0;
+      for (size_t bit = 0; bit < scale; bit++) {
+        double quadrant = unit();
+        from = 2 * from + (quadrant >= 0.76);
+        to = 2 * to + ((quadrant >= 0.57 && quadrant < 0.76) ||
+                       quadrant >= 0.95);
+      }
+      if (from < vertex_count && to < vertex_count) {
+        edges.emplace_back(from, to);
+      }
+    }
+  } else if (generator == "grid") {
+    size_t side = static_cast<size_t>(std::sqrt(vertex_count));
+    while (side * side > vertex_count) {
+      side--;
+    }
+    while ((side + 1) * (side + 1) <= vertex_count) {
+      side++;
+    }
+    for (size_t row = 0; row < side; row++) {
+      for (size_t column = 0; column < side; column++) {
+        size_t vertex = row * side + column;
+        if (column + 1 < side) {
+          edges.emplace_back(vertex, vertex + 1);
+        }
+        if (row + 1 < side) {
+          edges.emplace_back(vertex, vertex + side);
+        }
+      }
+    }
+  } else if (generator == "geometric") {
+    double radius = std::sqrt(kDegree / (std::numbers::pi * vertex_count));
+    size_t cells = std::max<size_t>(1, static_cast<size_t>(1 / radius));
+    std::vector<std::pair<double, double>> points(vertex_count);
+    std::vector<size_t> offsets(cells * cells + 1, 0);
+    auto cell_of = [cells](double coordinate) {
+      return std::min(cells - 1, static_cast<size_t>(coordinate * cells));
+    };
+    for (auto& point : points) {
+      point = {unit(), unit()};
+      ++offsets[cell_of(point.first) * cells + cell_of(point.second) + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<size_t> members(vertex_count);
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < vertex_count; i++) {
+      members[fill[cell_of(points[i].first) * cells +
+                   cell_of(points[i].second)]++] = i;
+    }
+    for (size_t i = 0; i < vertex_count; i++) {
+      size_t row = cell_of(points[i].first);
+      size_t column = cell_of(points[i].second);
+      for (size_t x = row - (row > 0); x <= std::min(row + 1, cells - 1);
+           x++) {
+        for (size_t y = column - (column > 0);
+             y <= std::min(column + 1, cells - 1); y++) {
+          for (size_t k = offsets[x * cells + y];
+               k < offsets[x * cells + y + 1]; k++) {
+            size_t j = members[k];
+            double dx = points[i].first - points[j].first;
+            double dy = points[i].second - points[j].second;
+            if (j > i && dx * dx + dy * dy < radius * radius) {
+              edges.emplace_back(i, j);
+            }
+          }
+        }
+      }
+    }
+  } else if (generator == "path") {
+    for (size_t i = 1; i < vertex_count; i++) {
+      edges.emplace_back(i - 1, i);
+    }
+  } else {
+    throw std::invalid_argument("unknown generator " +
+                                std::string(generator));
+  }
+  return edges;
+}
+
+void PrintDistances(const std::vector<int>& results, FastOutput& output) {
+  for (auto result : results) {
+    output << result << " ";
+  }
+  output << '\n';
+}
+
+template <std::unsigned_integral Index>
+void BenchSynthetic(std::string_view name, std::string_view generator,
+                    size_t vertex_count,
+                    const std::vector<std::pair<size_t, size_t>>& arcs,
+                    FastOutput& output) {
+  std::mt19937_64 random(2);
+  std::vector<std::vector<std::pair<Index, int>>> edges(vertex_count);
+  for (auto [from, to] : arcs) {
+    int weight = static_cast<int>(random() % 1000) + 1;
+    edges[from].emplace_back(to, weight);
+    edges[to].emplace_back(from, weight);
+  }
+  ReportThroughput(
+      name, generator, vertex_count, "edges", arcs.size(),
+      [&]() { Dijkstra(edges, vertex_count, Index{0}); }, output);
+}
+
+// Reads one test into lists of Index ids and answers, converts or times it.
+template <std::unsigned_integral Index>
+void Solve(size_t vertex_count, size_t edge_count, std::ofstream& binary,
+           bool bench, FastInput& input, FastOutput& output) {
+  std::vector<std::vector<std::pair<Index, int>>> edges(
+      vertex_count, std::vector<std::pair<Index, int>>());
+  std::vector<std::pair<uint64_t, uint64_t>> edge_list;
+  std::vector<int64_t> weights;
+  for (size_t i = 0; i < edge_count; i++) {
+    Index start_edge;
+    Index end_edge;
+    int weight;
+    input >> start_edge >> end_edge >> weight;
+    if (binary.is_open()) {
+      edge_list.emplace_back(start_edge, end_edge);
+      weights.push_back(weight);
+      continue;
+    }
+    edges[start_edge].emplace_back(end_edge, weight);
+    edges[end_edge].emplace_back(start_edge, weight);
+  }
+  Index start;
+  input >> start;
+  if (binary.is_open()) {
+    BinaryGraphHeader header;
+    header.flags =
+        BinaryGraphHeader::kUndirected | BinaryGraphHeader::kWeighted;
+    header.vertex_count = vertex_count;
+    header.id_bound = vertex_count;
+    header.source = start;
+    WriteBinaryGraph(binary, header, edge_list, weights);
+    return;
+  }
+  if (bench) {
+    Dijkstra(edges, vertex_count, start);
+    ReportKernel(
+        "dijkstra", "input",
+        [&]() { Dijkstra(edges, vertex_count, start); }, output);
+    std::vector<Index> new_ids;
+    std::vector<std::vector<std::pair<Index, int>>> reordered;
+    ReportKernel(
+        "relabel", "rcm",
+        [&]() {
+          new_ids = ReverseCuthillMcKee(edges);
+          reordered = Relabel(edges, new_ids);
+        },
+        output);
+    Dijkstra(reordered, vertex_count, new_ids[start]);
+    ReportKernel(
+        "dijkstra", "rcm",
+        [&]() { Dijkstra(reordered, vertex_count, new_ids[start]); },
+        output);
+    CompressedAdjacency compressed(edges);
+    for (auto& arcs : edges) {
+      std::sort(arcs.begin(), arcs.end());
+    }
+    ReportBytes("nested", NestedBytes(edges), output);
+    ReportBytes("compressed", compressed.ByteSize(), output);
+    Dijkstra(edges, vertex_count, start);
+    ReportKernel(
+        "dijkstra", "sorted",
+        [&]() { Dijkstra(edges, vertex_count, start); }, output);
+    Dijkstra(compressed, vertex_count, start);
+    ReportKernel(
+        "dijkstra", "compressed",
+        [&]() { Dijkstra(compressed, vertex_count, start); }, output);
+    return;
+  }
+  PrintDistances(Dijkstra(edges, vertex_count, start), output);
+}
+
+// With no arguments the task reads text from stdin; "--convert file" writes
+// every test as a binary graph record with the start in the header and
+// "file" answers from such records. Ids are 32-bit in every test whose
+// vertex count fits. "--bench" times every test on the input order, on the
+// RCM order and on sorted nested against compressed lists; "--bench
+// generator size" times Dijkstra on a synthetic graph with 64-bit and with
+// 32-bit ids.
+int main(int argc, char** argv) {
+  FastOutput output;
+  if (argc == 4 && std::string_view(argv[1]) == "--bench") {
+    size_t vertex_count = std::stoull(argv[3]);
+    std::vector<std::pair<size_t, size_t>> arcs =
+        SyntheticEdges(argv[2], vertex_count);
+    BenchSynthetic<uint64_t>("dijkstra_uint64", argv[2], vertex_count, arcs,
+                             output);
+    if (vertex_count <= std::numeric_limits<uint32_t>::max()) {
+      BenchSynthetic<uint32_t>("dijkstra_uint32", argv[2], vertex_count,
+                               arcs, output);
+    }
+    return 0;
+  }
+  bool bench = argc == 2 && std::string_view(argv[1]) == "--bench";
+  if (argc == 2 && !bench) {
+    MappedFile file(argv[1]);
+    std::span<const std::byte> bytes = file.Bytes();
+    while (!bytes.empty()) {
+      BinaryGraph record(bytes);
+      MappedAdjacency edges(record);
+      PrintDistances(Dijkstra(edges, record.Header().vertex_count,
+                              record.Header().source),
+                     output);
+      bytes = bytes.subspan(record.ByteSize());
+    }
+    return 0;
+  }
+  FastInput input;
+  std::ofstream binary;
+  if (argc == 3 && std::string_view(argv[1]) == "--convert") {
+    binary.open(argv[2], std::ios::binary);
+  }
   size_t count;
-  std::cin >> count;
+  input >> count;
   for (size_t count_no = 0; count_no < count; count_no++) {
     size_t vertex_count;
     size_t edge_count;
-    std::cin >> vertex_count >> edge_count;
-    std::vector<std::vector<std::pair<size_t, int>>> edges(
-        vertex_count, std::vector<std::pair<size_t, int>>());
-    for (size_t i = 0; i < edge_count; i++) {
-      size_t start_edge;
-      size_t end_edge;
-      int weight;
-      std::cin >> start_edge >> end_edge >> weight;
-      edges[start_edge].emplace_back(end_edge, weight);
-      edges[end_edge].emplace_back(start_edge, weight);
-    }
-    size_t start;
-    std::cin >> start;
-    auto results = Dijkstra(edges, vertex_count, start);
-    for (auto result : results) {
-      std::cout << result << " ";
-    }
-    std::cout << std::endl;
+    input >> vertex_count >> edge_count;
+    if (vertex_count <= std::numeric_limits<uint32_t>::max()) {
+      Solve<uint32_t>(vertex_count, edge_count, binary, bench, input, output);
+    } else {
+      Solve<uint64_t>(vertex_count, edge_count, binary, bench, input, output);
+    }
   }
   return 0;
-}
\ No newline at end of file
+}
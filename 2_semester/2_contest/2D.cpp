@@ -1,11 +1,173 @@
+#include <unistd.h>
+
 #include <algorithm>
-#include <iostream>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <numbers>
 #include <numeric>
 #include <queue>
+#include <random>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
 static constexpr int64_t kInf = 30000;
 
 struct Edge {
@@ -31,26 +193,159 @@ std::vector<int64_t> FordBellman(std::vector<Edge>& edges, size_t vertex_count,
   return result;
 }
 
-int main() {
-  std::ios_base::sync_with_stdio(false);
-  std::cin.tie(nullptr);
-  std::cout.tie(nullptr);
+// Runs kernel once on a synthetic input and prints its throughput as one
+// JSON object per line; count is the number of units the kernel processed.
+template <class Kernel>
+void ReportThroughput(std::string_view name, std::string_view generator,
+                      size_t size, std::string_view unit, size_t count,
+                      Kernel&& kernel, FastOutput& output) {
+  auto begin = std::chrono::steady_clock::now();
+  kernel();
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  uint64_t microseconds = std::max<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(),
+      1);
+  output << "{\"kernel\": \"" << name << "\", \"generator\": \"" << generator
+         << "\", \"size\": " << size << ", \"" << unit << "\": " << count
+         << ", \"microseconds\": " << microseconds << ", \"" << unit
+         << "_per_second\": " << count * 1000000 / microseconds << "}\n";
+}
+
+// Deterministic synthetic graphs for the benchmarks: the same generator,
+// vertex count and seed always give the same edges over [0, vertex_count).
+// "rmat" is a power-law R-MAT graph and "geometric" joins random points of
+// the unit square that are close enough for about eight neighbours each;
+// "grid" is the largest square 4-neighbour grid that fits and "path" one
+// long path.
+std::vector<std::pair<size_t, size_t>> SyntheticEdges(
+    std::string_view generator, size_t vertex_count, uint64_t seed = 1) {
+  static constexpr size_t kDegree = 8;
+  std::mt19937_64 random(seed);
+  auto unit = [&random]() {
+    return static_cast<double>(random() >> 11) * 0x1p-53;
+  };
+  std::vector<std::pair<size_t, size_t>> edges;
+  if (generator == "rmat") {
+    size_t scale = std::bit_width(std::max<size_t>(vertex_count, 2) - 1);
+    edges.reserve(vertex_count * kDegree / 2);
+    while (edges.size() < vertex_count * kDegree / 2) {
+      size_t from = 0;
+      size_t to = 0;
+      for (size_t bit = 0; bit < scale; bit++) {
+        double quadrant = unit();
+        from = 2 * from + (quadrant >= 0.76);
+        to = 2 * to + ((quadrant >= 0.57 && quadrant < 0.76) ||
+                       quadrant >= 0.95);
+      }
+      if (from < vertex_count && to < vertex_count) {
+        edges.emplace_back(from, to);
+      }
+    }
+  } else if (generator == "grid") {
+    size_t side = static_cast<size_t>(std::sqrt(vertex_count));
+    while (side * side > vertex_count) {
+      side--;
+    }
+    while ((side + 1) * (side + 1) <= vertex_count) {
+      side++;
+    }
+    for (size_t row = 0; row < side; row++) {
+      for (size_t column = 0; column < side; column++) {
+        size_t vertex = row * side + column;
+        if (column + 1 < side) {
+          edges.emplace_back(vertex, vertex + 1);
+        }
+        if (row + 1 < side) {
+          edges.emplace_back(vertex, vertex + side);
+        }
+      }
+    }
+  } else if (generator == "geometric") {
+    double radius = std::sqrt(kDegree / (std::numbers::pi * vertex_count));
+    size_t cells = std::max<size_t>(1, static_cast<size_t>(1 / radius));
+    std::vector<std::pair<double, double>> points(vertex_count);
+    std::vector<size_t> offsets(cells * cells + 1, 0);
+    auto cell_of = [cells](double coordinate) {
+      return std::min(cells - 1, static_cast<size_t>(coordinate * cells));
+    };
+    for (auto& point : points) {
+      point = {unit(), unit()};
+      ++offsets[cell_of(point.first) * cells + cell_of(point.second) + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<size_t> members(vertex_count);
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < vertex_count; i++) {
+      members[fill[cell_of(points[i].first) * cells +
+                   cell_of(points[i].second)]++] = i;
+    }
+    for (size_t i = 0; i < vertex_count; i++) {
+      size_t row = cell_of(points[i].first);
+      size_t column = cell_of(points[i].second);
+      for (size_t x = row - (row > 0); x <= std::min(row + 1, cells - 1);
+           x++) {
+        for (size_t y = column - (column > 0);
+             y <= std::min(column + 1, cells - 1); y++) {
+          for (size_t k = offsets[x * cells + y];
+               k < offsets[x * cells + y + 1]; k++) {
+            size_t j = members[k];
+            double dx = points[i].first - points[j].first;
+            double dy = points[i].second - points[j].second;
+            if (j > i && dx * dx + dy * dy < radius * radius) {
+              edges.emplace_back(i, j);
+            }
+          }
+        }
+      }
+    }
+  } else if (generator == "path") {
+    for (size_t i = 1; i < vertex_count; i++) {
+      edges.emplace_back(i - 1, i);
+    }
+  } else {
+    throw std::invalid_argument("unknown generator " +
+                                std::string(generator));
+  }
+  return edges;
+}
+
+// "--bench generator size" times FordBellman on a synthetic graph with arcs
+// in both directions of every edge.
+int main(int argc, char** argv) {
+  FastInput input;
+  FastOutput output;
+  if (argc == 4 && std::string_view(argv[1]) == "--bench") {
+    size_t vertex_count = std::stoull(argv[3]);
+    std::mt19937_64 random(2);
+    std::vector<Edge> edges;
+    for (auto [from, to] : SyntheticEdges(argv[2], vertex_count)) {
+      int64_t weight = static_cast<int64_t>(random() % 100) + 1;
+      edges.emplace_back(from, to, weight);
+      edges.emplace_back(to, from, weight);
+    }
+    size_t passes = vertex_count > 2 ? vertex_count - 2 : 0;
+    ReportThroughput(
+        "ford_bellman", argv[2], vertex_count, "relaxations",
+        edges.size() * passes,
+        [&]() { FordBellman(edges, vertex_count, 0); }, output);
+    return 0;
+  }
   size_t vertex_count;
   size_t edge_count;
-  std::cin >> vertex_count >> edge_count;
+  input >> vertex_count >> edge_count;
   std::vector<Edge> edges;
   for (size_t i = 0; i < edge_count; i++) {
     size_t from;
     size_t to;
     int64_t weight;
-    std::cin >> from >> to >> weight;
+    input >> from >> to >> weight;
     from--;
     to--;
     edges.emplace_back(from, to, weight);
   }
   auto result = FordBellman(edges, vertex_count, 0);
   for (auto weight : result) {
-    std::cout << weight << " ";
+    output << weight << " ";
   }
   return 0;
 }
\ No newline at end of file
@@ -1,59 +1,393 @@
+#include <unistd.h>
+
 #include <algorithm>
-#include <iostream>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
 #include <queue>
-#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
-void DFS(size_t current, size_t root,
-         std::vector<std::set<size_t>>& trans_graph, std::vector<bool>& used,
-         std::vector<std::vector<size_t>>& graph) {
-  used[current] = true;
-  for (size_t vertex : graph[current]) {
-    if (!used[vertex]) {
-      DFS(vertex, root, trans_graph, used, graph);
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
     }
+    buffer_[size_++] = symbol;
+    return *this;
   }
-  trans_graph[root].insert(current);
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
+// Hooks get IsVisited(v), Enter(v), TreeEdge(from, to) before descending,
+// BackEdge(from, to, parent) for edges to visited vertices (false stops the
+// traversal) and Exit(parent, child) once child is finished; the root is
+// its own parent.
+template <class VType, class Neighbours, class Hooks>
+bool IterativeDFS(VType root, Neighbours&& neighbours, Hooks& hooks) {
+  struct Frame {
+    VType vertex;
+    size_t next;
+  };
+  std::vector<Frame> stack;
+  hooks.Enter(root);
+  stack.push_back({root, 0});
+  while (!stack.empty()) {
+    VType current = stack.back().vertex;
+    auto&& adjacent = neighbours(current);
+    if (stack.back().next == adjacent.size()) {
+      stack.pop_back();
+      hooks.Exit(stack.empty() ? current : stack.back().vertex, current);
+      continue;
+    }
+    VType vertex = adjacent[stack.back().next++];
+    if (!hooks.IsVisited(vertex)) {
+      hooks.TreeEdge(current, vertex);
+      hooks.Enter(vertex);
+      stack.push_back({vertex, 0});
+    } else {
+      VType parent =
+          stack.size() > 1 ? stack[stack.size() - 2].vertex : current;
+      if (!hooks.BackEdge(current, vertex, parent)) {
+        return false;
+      }
+    }
+  }
+  return true;
 }
 
+// Pearce's single-array variant of Tarjan: rindex holds the DFS index of an
+// active vertex and the pop number (counting down from kFirstComponent) of a
+// finished one, so no transpose and no separate low array are needed.
+class PearceHooks {
+ public:
+  static constexpr size_t kExcluded = std::numeric_limits<size_t>::max();
+  static constexpr size_t kFirstComponent = kExcluded - 1;
+
+  explicit PearceHooks(std::vector<size_t>& rindex)
+      : rindex_(rindex), root_(rindex.size(), false) {}
+  bool IsVisited(size_t vertex) { return rindex_[vertex] != 0; }
+  void Enter(size_t vertex) {
+    rindex_[vertex] = index_++;
+    root_[vertex] = true;
+  }
+  void TreeEdge(size_t from, size_t to) {}
+  bool BackEdge(size_t from, size_t to, size_t parent) {
+    Lower(from, to);
+    return true;
+  }
+  void Exit(size_t parent, size_t child) {
+    if (root_[child]) {
+      index_--;
+      while (!stack_.empty() && rindex_[child] <= rindex_[stack_.back()]) {
+        rindex_[stack_.back()] = component_;
+        stack_.pop_back();
+        index_--;
+      }
+      rindex_[child] = component_--;
+    } else {
+      stack_.push_back(child);
+    }
+    if (parent != child) {
+      Lower(parent, child);
+    }
+  }
+  size_t PopCount() const { return kFirstComponent - component_; }
+
+ private:
+  void Lower(size_t vertex, size_t other) {
+    if (rindex_[other] < rindex_[vertex]) {
+      rindex_[vertex] = rindex_[other];
+      root_[vertex] = false;
+    }
+  }
+
+  std::vector<size_t>& rindex_;
+  std::vector<bool> root_;
+  std::vector<size_t> stack_;
+  size_t index_ = 1;
+  size_t component_ = kFirstComponent;
+};
+
+// Runs the DFS over every vertex whose rindex is still 0; afterwards
+// kFirstComponent - rindex[v] is the pop number of v's component.
+size_t PearceDFS(std::vector<std::vector<size_t>>& graph,
+                 std::vector<size_t>& rindex) {
+  PearceHooks hooks(rindex);
+  for (size_t i = 0; i < graph.size(); i++) {
+    if (rindex[i] == 0) {
+      IterativeDFS(
+          i,
+          [&graph](size_t vertex) -> std::vector<size_t>& {
+            return graph[vertex];
+          },
+          hooks);
+    }
+  }
+  return hooks.PopCount();
+}
+
+template <class Function>
+void ParallelFor(size_t count, size_t thread_count, Function&& function) {
+  static constexpr size_t kChunk = 1024;
+  thread_count = std::max<size_t>(thread_count, 1);
+  std::atomic<size_t> cursor = 0;
+  auto worker = [&]() {
+    for (size_t begin = cursor.fetch_add(kChunk); begin < count;
+         begin = cursor.fetch_add(kChunk)) {
+      size_t end = std::min(begin + kChunk, count);
+      for (size_t i = begin; i < end; i++) {
+        function(i);
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t id = 1; id < thread_count; id++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Rows are packed 64 vertices per word and kept per strongly connected
+// component: components come out of PearceDFS sinks first, so every row is
+// its own vertices OR-ed with the finished rows of its successors. Components
+// of equal height in the condensation are independent and filled in
+// parallel.
+class ReachabilityMatrix {
+ public:
+  explicit ReachabilityMatrix(std::vector<std::vector<size_t>>& graph,
+                              size_t thread_count = 1)
+      : words_((graph.size() + 63) / 64), component_(graph.size(), 0) {
+    size_t vertex_count = graph.size();
+    size_t count = PearceDFS(graph, component_);
+    for (size_t& component : component_) {
+      component = PearceHooks::kFirstComponent - component;
+    }
+    std::vector<std::vector<size_t>> members(count);
+    std::vector<std::vector<size_t>> successors(count);
+    std::vector<size_t> seen(count, std::numeric_limits<size_t>::max());
+    for (size_t i = 0; i < vertex_count; i++) {
+      members[component_[i]].push_back(i);
+    }
+    std::vector<size_t> height(count, 0);
+    size_t max_height = 0;
+    for (size_t component = 0; component < count; component++) {
+      for (size_t vertex : members[component]) {
+        for (size_t next : graph[vertex]) {
+          size_t successor = component_[next];
+          if (successor != component && seen[successor] != component) {
+            seen[successor] = component;
+            successors[component].push_back(successor);
+            height[component] =
+                std::max(height[component], height[successor] + 1);
+          }
+        }
+      }
+      max_height = std::max(max_height, height[component]);
+    }
+    std::vector<std::vector<size_t>> levels(max_height + 1);
+    for (size_t component = 0; component < count; component++) {
+      levels[height[component]].push_back(component);
+    }
+    rows_.assign(count * words_, 0);
+    for (const std::vector<size_t>& level : levels) {
+      ParallelFor(level.size(), thread_count, [&](size_t i) {
+        size_t component = level[i];
+        uint64_t* row = rows_.data() + component * words_;
+        for (size_t vertex : members[component]) {
+          row[vertex / 64] |= uint64_t{1} << (vertex % 64);
+        }
+        for (size_t successor : successors[component]) {
+          const uint64_t* other = rows_.data() + successor * words_;
+          for (size_t word = 0; word < words_; word++) {
+            row[word] |= other[word];
+          }
+        }
+      });
+    }
+  }
+  bool Get(size_t from, size_t to) const {
+    return ((Row(from)[to / 64] >> (to % 64)) & 1) != 0;
+  }
+  const uint64_t* Row(size_t vertex) const {
+    return rows_.data() + component_[vertex] * words_;
+  }
+
+ private:
+  size_t words_;
+  std::vector<size_t> component_;
+  std::vector<uint64_t> rows_;
+};
+
 int main() {
-  std::ios_base::sync_with_stdio(false);
-  std::cin.tie(nullptr);
-  std::cout.tie(nullptr);
+  FastInput input;
+  FastOutput output;
   size_t vertex_count;
-  std::cin >> vertex_count;
+  input >> vertex_count;
   std::vector<std::vector<size_t>> graph(vertex_count, std::vector<size_t>());
   for (size_t i = 0; i < vertex_count; i++) {
     for (size_t j = 0; j < vertex_count; j++) {
       short edge;
-      std::cin >> edge;
+      input >> edge;
       if (edge == 1) {
         graph[i].push_back(j);
       }
     }
   }
-  std::vector<std::set<size_t>> trans_graph(vertex_count);
-  std::vector<bool> used(vertex_count, false);
+  ReachabilityMatrix closure(graph);
+  std::string line(2 * vertex_count, ' ');
   for (size_t i = 0; i < vertex_count; i++) {
-    DFS(i, i, trans_graph, used, graph);
-    used.assign(vertex_count, false);
-  }
-  for (size_t i = 0; i < vertex_count; i++) {
-    size_t current = 0;
-    for (auto vertex : trans_graph[i]) {
-      while (current < vertex) {
-        std::cout << 0 << ' ';
-        current++;
-      }
-      std::cout << 1 << ' ';
-      current++;
-    }
-    while (current < vertex_count) {
-      std::cout << 0 << ' ';
-      current++;
+    for (size_t j = 0; j < vertex_count; j++) {
+      line[2 * j] = closure.Get(i, j) ? '1' : '0';
     }
-    std::cout << '\n';
+    output << line << '\n';
   }
   return 0;
 }
\ No newline at end of file
@@ -1,50 +1,244 @@
+#include <unistd.h>
+
 #include <algorithm>
-#include <iostream>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <numeric>
 #include <queue>
+#include <random>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
-template <typename EType>
-class DSU {
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
  public:
-  void Unite(EType first, EType second) {
-    EType first_set = FindSet(first);
-    EType second_set = FindSet(second);
-    if (first_set != second_set) {
-      if (ranks_[first_set] < ranks_[second_set]) {
-        std::swap(first_set, second_set);
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
       }
-      ancestors_[second_set] = first_set;
-      if (ranks_[first_set] == ranks_[second_set]) {
-        ++ranks_[first_set];
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
       }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
     }
+    return -1;
   }
-  bool AreSame(EType first, EType second) {
-    return FindSet(first) == FindSet(second);
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
   }
-  DSU(std::vector<EType>& elements) : ancestors_(elements) {
-    ranks_.assign(elements.size(), 0);
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
   }
 
  private:
-  EType FindSet(EType element) {
-    if (element == ancestors_[element]) {
-      return element;
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
     }
-    return ancestors_[element] = FindSet(ancestors_[element]);
   }
-  std::unordered_map<EType, EType> ancestors_;
-  std::unordered_map<EType, size_t> ranks_;
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
 };
 
-template <>
-class DSU<size_t> {
+// Pairs, tuples and arrays hash by combining the hashes of their members;
+// every other key goes to std::hash.
+template <class Key>
+struct KeyHash {
+  size_t operator()(const Key& key) const {
+    if constexpr (requires { std::tuple_size<Key>::value; }) {
+      return std::apply(
+          [](const auto&... parts) {
+            size_t seed = 0;
+            ((seed ^= KeyHash<std::decay_t<decltype(parts)>>()(parts) +
+                      0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2)),
+             ...);
+            return seed;
+          },
+          key);
+    } else {
+      return std::hash<Key>()(key);
+    }
+  }
+};
+
+// Gives every distinct key a dense id in order of first appearance, so the
+// structures over arbitrary keys keep their state in vectors and hash a key
+// only where it crosses the interface.
+template <class Key>
+class Interner {
+ public:
+  static constexpr uint32_t kMissing = std::numeric_limits<uint32_t>::max();
+
+  Interner() = default;
+  explicit Interner(const std::vector<Key>& keys) {
+    for (const Key& key : keys) {
+      Intern(key);
+    }
+  }
+  uint32_t Intern(const Key& key) {
+    auto [it, inserted] =
+        ids_.try_emplace(key, static_cast<uint32_t>(keys_.size()));
+    if (inserted) {
+      keys_.push_back(key);
+    }
+    return it->second;
+  }
+  // Throws std::out_of_range for a key that was never interned.
+  uint32_t Id(const Key& key) const { return ids_.at(key); }
+  uint32_t Find(const Key& key) const {
+    auto it = ids_.find(key);
+    return it == ids_.end() ? kMissing : it->second;
+  }
+  const Key& KeyOf(uint32_t id) const { return keys_[id]; }
+  size_t Size() const { return keys_.size(); }
+
+ private:
+  std::unordered_map<Key, uint32_t, KeyHash<Key>> ids_;
+  std::vector<Key> keys_;
+};
+
+template <typename EType, std::unsigned_integral Index = uint32_t>
+class DSU;
+
+// Parents are stored as Index and ranks, which never exceed the log of the
+// size, as bytes; the size has to fit in an Index.
+template <std::unsigned_integral Index>
+class DSU<size_t, Index> {
  public:
   void Unite(size_t first, size_t second) {
-    size_t first_set = FindSet(first);
-    size_t second_set = FindSet(second);
+    Index first_set = FindSet(first);
+    Index second_set = FindSet(second);
     if (first_set != second_set) {
       if (ranks_[first_set] < ranks_[second_set]) {
         std::swap(first_set, second_set);
@@ -59,6 +253,9 @@ class DSU<size_t> {
     return FindSet(first) == FindSet(second);
   }
   DSU(size_t size) {
+    if (size > std::numeric_limits<Index>::max()) {
+      throw std::length_error("DSU size does not fit the index type");
+    }
     ancestors_.resize(size);
     ranks_.assign(size, 0);
     for (size_t i = 0; i < size; i++) {
@@ -67,62 +264,45 @@ class DSU<size_t> {
   }
 
  private:
-  size_t FindSet(size_t element) {
+  Index FindSet(size_t element) {
     if (element == ancestors_[element]) {
       return element;
     }
     return ancestors_[element] = FindSet(ancestors_[element]);
   }
-  std::vector<size_t> ancestors_;
-  std::vector<size_t> ranks_;
+  std::vector<Index> ancestors_;
+  std::vector<uint8_t> ranks_;
 };
 
-template <typename EType, typename WType>
-class WeightedDSU {
+// Interns the elements once and runs the dense forest on their ids.
+template <typename EType, std::unsigned_integral Index>
+class DSU {
  public:
-  void Unite(const EType& first, const EType& second, const WType& weight) {
-    EType first_set = FindSet(first);
-    EType second_set = FindSet(second);
-    if (first_set != second_set) {
-      if (ranks_[first_set] < ranks_[second_set]) {
-        std::swap(first_set, second_set);
-      }
-      weights_[first_set] += weights_[second_set] + weight;
-      ancestors_[second_set] = first_set;
-      if (ranks_[first_set] == ranks_[second_set]) {
-        ++ranks_[first_set];
-      }
-    } else {
-      weights_[first_set] += weight;
-    }
+  void Unite(const EType& first, const EType& second) {
+    forest_.Unite(ids_.Id(first), ids_.Id(second));
   }
   bool AreSame(const EType& first, const EType& second) {
-    return FindSet(first) == FindSet(second);
-  }
-  WType GetWeight(const EType& element) { return weights_[FindSet(element)]; }
-  WeightedDSU(const std::vector<EType>& elements) : ancestors_(elements) {
-    ranks_.assign(elements.size(), 0);
-    weights_.assign(elements.size(), 0);
+    return forest_.AreSame(ids_.Id(first), ids_.Id(second));
   }
+  DSU(const std::vector<EType>& elements)
+      : ids_(elements), forest_(ids_.Size()) {}
 
  private:
-  EType FindSet(const EType& element) {
-    if (element == ancestors_[element]) {
-      return element;
-    }
-    return ancestors_[element] = FindSet(ancestors_[element]);
-  }
-  std::unordered_map<EType, EType> ancestors_;
-  std::unordered_map<EType, size_t> ranks_;
-  std::unordered_map<EType, WType> weights_;
+  Interner<EType> ids_;
+  DSU<size_t, Index> forest_;
 };
 
-template <typename WType>
-class WeightedDSU<size_t, WType> {
+template <typename EType, typename WType,
+          std::unsigned_integral Index = uint32_t>
+class WeightedDSU;
+
+// The same layout as DSU<size_t, Index>, plus the weight of every set.
+template <typename WType, std::unsigned_integral Index>
+class WeightedDSU<size_t, WType, Index> {
  public:
   void Unite(const size_t& first, const size_t& second, const WType& weight) {
-    size_t first_set = FindSet(first);
-    size_t second_set = FindSet(second);
+    Index first_set = FindSet(first);
+    Index second_set = FindSet(second);
     if (first_set != second_set) {
       if (ranks_[first_set] < ranks_[second_set]) {
         std::swap(first_set, second_set);
@@ -141,6 +321,9 @@ class WeightedDSU<size_t, WType> {
   }
   WType GetWeight(const size_t& element) { return weights_[FindSet(element)]; }
   WeightedDSU(size_t size) {
+    if (size > std::numeric_limits<Index>::max()) {
+      throw std::length_error("DSU size does not fit the index type");
+    }
     weights_.assign(size, 0);
     ancestors_.assign(size, 0);
     ranks_.assign(size, 0);
@@ -150,41 +333,220 @@ class WeightedDSU<size_t, WType> {
   }
 
  private:
-  size_t FindSet(const size_t& element) {
+  Index FindSet(const size_t& element) {
     if (element == ancestors_[element]) {
       return element;
     }
     return ancestors_[element] = FindSet(ancestors_[element]);
   }
-  std::vector<size_t> ancestors_;
-  std::vector<size_t> ranks_;
+  std::vector<Index> ancestors_;
+  std::vector<uint8_t> ranks_;
   std::vector<WType> weights_;
 };
 
-int main() {
-  std::ios_base::sync_with_stdio(false);
-  std::cin.tie(nullptr);
-  std::cout.tie(nullptr);
+// Interns the elements once and runs the dense forest on their ids.
+template <typename EType, typename WType, std::unsigned_integral Index>
+class WeightedDSU {
+ public:
+  void Unite(const EType& first, const EType& second, const WType& weight) {
+    forest_.Unite(ids_.Id(first), ids_.Id(second), weight);
+  }
+  bool AreSame(const EType& first, const EType& second) {
+    return forest_.AreSame(ids_.Id(first), ids_.Id(second));
+  }
+  WType GetWeight(const EType& element) {
+    return forest_.GetWeight(ids_.Id(element));
+  }
+  WeightedDSU(const std::vector<EType>& elements)
+      : ids_(elements), forest_(ids_.Size()) {}
+
+ private:
+  Interner<EType> ids_;
+  WeightedDSU<size_t, WType, Index> forest_;
+};
+
+// Runs kernel once on a synthetic input and prints its throughput as one
+// JSON object per line; count is the number of units the kernel processed.
+template <class Kernel>
+void ReportThroughput(std::string_view name, std::string_view generator,
+                      size_t size, std::string_view unit, size_t count,
+                      Kernel&& kernel, FastOutput& output) {
+  auto begin = std::chrono::steady_clock::now();
+  kernel();
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  uint64_t microseconds = std::max<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(),
+      1);
+  output << "{\"kernel\": \"" << name << "\", \"generator\": \"" << generator
+         << "\", \"size\": " << size << ", \"" << unit << "\": " << count
+         << ", \"microseconds\": " << microseconds << ", \"" << unit
+         << "_per_second\": " << count * 1000000 / microseconds << "}\n";
+}
+
+// Deterministic synthetic graphs for the benchmarks: the same generator,
+// vertex count and seed always give the same edges over [0, vertex_count).
+// "rmat" is a power-law R-MAT graph and "geometric" joins random points of
+// the unit square that are close enough for about eight neighbours each;
+// "grid" is the largest square 4-neighbour grid that fits and "path" one
+// long path.
+std::vector<std::pair<size_t, size_t>> SyntheticEdges(
+    std::string_view generator, size_t vertex_count, uint64_t seed = 1) {
+  static constexpr size_t kDegree = 8;
+  std::mt19937_64 random(seed);
+  auto unit = [&random]() {
+    return static_cast<double>(random() >> 11) * 0x1p-53;
+  };
+  std::vector<std::pair<size_t, size_t>> edges;
+  if (generator == "rmat") {
+    size_t scale = std::bit_width(std::max<size_t>(vertex_count, 2) - 1);
+    edges.reserve(vertex_count * kDegree / 2);
+    while (edges.size() < vertex_count * kDegree / 2) {
+      size_t from = 0;
+      size_t to = 0;
+      for (size_t bit = 0; bit < scale; bit++) {
+        double quadrant = unit();
+        from = 2 * from + (quadrant >= 0.76);
+        to = 2 * to + ((quadrant >= 0.57 && quadrant < 0.76) ||
+                       quadrant >= 0.95);
+      }
+      if (from < vertex_count && to < vertex_count) {
+        edges.emplace_back(from, to);
+      }
+    }
+  } else if (generator == "grid") {
+    size_t side = static_cast<size_t>(std::sqrt(vertex_count));
+    while (side * side > vertex_count) {
+      side--;
+    }
+    while ((side + 1) * (side + 1) <= vertex_count) {
+      side++;
+    }
+    for (size_t row = 0; row < side; row++) {
+      for (size_t column = 0; column < side; column++) {
+        size_t vertex = row * side + column;
+        if (column + 1 < side) {
+          edges.emplace_back(vertex, vertex + 1);
+        }
+        if (row + 1 < side) {
+          edges.emplace_back(vertex, vertex + side);
+        }
+      }
+    }
+  } else if (generator == "geometric") {
+    double radius = std::sqrt(kDegree / (std::numbers::pi * vertex_count));
+    size_t cells = std::max<size_t>(1, static_cast<size_t>(1 / radius));
+    std::vector<std::pair<double, double>> points(vertex_count);
+    std::vector<size_t> offsets(cells * cells + 1, 0);
+    auto cell_of = [cells](double coordinate) {
+      return std::min(cells - 1, static_cast<size_t>(coordinate * cells));
+    };
+    for (auto& point : points) {
+      point = {unit(), unit()};
+      ++offsets[cell_of(point.first) * cells + cell_of(point.second) + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<size_t> members(vertex_count);
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < vertex_count; i++) {
+      members[fill[cell_of(points[i].first) * cells +
+                   cell_of(points[i].second)]++] = i;
+    }
+    for (size_t i = 0; i < vertex_count; i++) {
+      size_t row = cell_of(points[i].first);
+      size_t column = cell_of(points[i].second);
+      for (size_t x = row - (row > 0); x <= std::min(row + 1, cells - 1);
+           x++) {
+        for (size_t y = column - (column > 0);
+             y <= std::min(column + 1, cells - 1); y++) {
+          for (size_t k = offsets[x * cells + y];
+               k < offsets[x * cells + y + 1]; k++) {
+            size_t j = members[k];
+            double dx = points[i].first - points[j].first;
+            double dy = points[i].second - points[j].second;
+            if (j > i && dx * dx + dy * dy < radius * radius) {
+              edges.emplace_back(i, j);
+            }
+          }
+        }
+      }
+    }
+  } else if (generator == "path") {
+    for (size_t i = 1; i < vertex_count; i++) {
+      edges.emplace_back(i - 1, i);
+    }
+  } else {
+    throw std::invalid_argument("unknown generator " +
+                                std::string(generator));
+  }
+  return edges;
+}
+
+template <std::unsigned_integral Index>
+void BenchSynthetic(std::string_view width, std::string_view generator,
+                    size_t element_count,
+                    const std::vector<std::pair<size_t, size_t>>& edges,
+                    FastOutput& output) {
+  DSU<size_t, Index> dsu(element_count);
+  ReportThroughput(
+      "dsu_" + std::string(width), generator, element_count, "queries",
+      2 * edges.size(),
+      [&]() {
+        for (auto [first, second] : edges) {
+          dsu.Unite(first, second);
+          dsu.AreSame(first, second);
+        }
+      },
+      output);
+  WeightedDSU<size_t, size_t, Index> weighted(element_count);
+  ReportThroughput(
+      "weighted_dsu_" + std::string(width), generator, element_count,
+      "queries", 2 * edges.size(),
+      [&]() {
+        for (auto [first, second] : edges) {
+          weighted.Unite(first, second, 1);
+          weighted.GetWeight(second);
+        }
+      },
+      output);
+}
+
+// "--bench generator size" unites the ends of every edge of a synthetic graph
+// and then looks both of them up, once with 64-bit and once with 32-bit
+// parents.
+int main(int argc, char** argv) {
+  FastInput input;
+  FastOutput output;
+  if (argc == 4 && std::string_view(argv[1]) == "--bench") {
+    size_t element_count = std::stoull(argv[3]);
+    std::vector<std::pair<size_t, size_t>> edges =
+        SyntheticEdges(argv[2], element_count);
+    BenchSynthetic<uint64_t>("uint64", argv[2], element_count, edges, output);
+    if (element_count <= std::numeric_limits<uint32_t>::max()) {
+      BenchSynthetic<uint32_t>("uint32", argv[2], element_count, edges,
+                               output);
+    }
+    return 0;
+  }
   size_t student_count;
   size_t query_count;
-  std::cin >> student_count >> query_count;
+  input >> student_count >> query_count;
   WeightedDSU<size_t, size_t> dsu(student_count);
   for (size_t i = 0; i < query_count; i++) {
     size_t query;
-    std::cin >> query;
+    input >> query;
     if (query == 1) {
       size_t first;
       size_t second;
       size_t weight;
-      std::cin >> first >> second >> weight;
+      input >> first >> second >> weight;
       --first;
       --second;
       dsu.Unite(first, second, weight);
     } else {
       size_t element;
-      std::cin >> element;
+      input >> element;
       --element;
-      std::cout << dsu.GetWeight(element) << '\n';
+      output << dsu.GetWeight(element) << '\n';
     }
   }
   return 0;
@@ -1,52 +1,240 @@
+#include <unistd.h>
+
 #include <algorithm>
-#include <iostream>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
 #include <queue>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
-constexpr size_t kInf = std::numeric_limits<size_t>::max();
-
-template <typename EType>
-class DSU {
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
  public:
-  void Unite(EType first, EType second) {
-    EType first_set = FindSet(first);
-    EType second_set = FindSet(second);
-    if (first_set != second_set) {
-      if (ranks_[first_set] < ranks_[second_set]) {
-        std::swap(first_set, second_set);
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
       }
-      ancestors_[second_set] = first_set;
-      if (ranks_[first_set] == ranks_[second_set]) {
-        ++ranks_[first_set];
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
       }
+      ++position_;
     }
+    return -1;
   }
-  bool AreSame(EType first, EType second) {
-    return FindSet(first) == FindSet(second);
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
   }
-  DSU(std::vector<EType>& elements) : ancestors_(elements) {
-    ranks_.assign(elements.size(), 0);
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
   }
 
  private:
-  EType FindSet(EType element) {
-    if (element == ancestors_[element]) {
-      return element;
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
     }
-    return ancestors_[element] = FindSet(ancestors_[element]);
   }
-  std::unordered_map<EType, EType> ancestors_;
-  std::unordered_map<EType, size_t> ranks_;
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
+constexpr size_t kInf = std::numeric_limits<size_t>::max();
+
+// Pairs, tuples and arrays hash by combining the hashes of their members;
+// every other key goes to std::hash.
+template <class Key>
+struct KeyHash {
+  size_t operator()(const Key& key) const {
+    if constexpr (requires { std::tuple_size<Key>::value; }) {
+      return std::apply(
+          [](const auto&... parts) {
+            size_t seed = 0;
+            ((seed ^= KeyHash<std::decay_t<decltype(parts)>>()(parts) +
+                      0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2)),
+             ...);
+            return seed;
+          },
+          key);
+    } else {
+      return std::hash<Key>()(key);
+    }
+  }
+};
+
+// Gives every distinct key a dense id in order of first appearance, so the
+// structures over arbitrary keys keep their state in vectors and hash a key
+// only where it crosses the interface.
+template <class Key>
+class Interner {
+ public:
+  static constexpr uint32_t kMissing = std::numeric_limits<uint32_t>::max();
+
+  Interner() = default;
+  explicit Interner(const std::vector<Key>& keys) {
+    for (const Key& key : keys) {
+      Intern(key);
+    }
+  }
+  uint32_t Intern(const Key& key) {
+    auto [it, inserted] =
+        ids_.try_emplace(key, static_cast<uint32_t>(keys_.size()));
+    if (inserted) {
+      keys_.push_back(key);
+    }
+    return it->second;
+  }
+  // Throws std::out_of_range for a key that was never interned.
+  uint32_t Id(const Key& key) const { return ids_.at(key); }
+  uint32_t Find(const Key& key) const {
+    auto it = ids_.find(key);
+    return it == ids_.end() ? kMissing : it->second;
+  }
+  const Key& KeyOf(uint32_t id) const { return keys_[id]; }
+  size_t Size() const { return keys_.size(); }
+
+ private:
+  std::unordered_map<Key, uint32_t, KeyHash<Key>> ids_;
+  std::vector<Key> keys_;
 };
 
-template <>
-class DSU<size_t> {
+template <typename EType, std::unsigned_integral Index = uint32_t>
+class DSU;
+
+// Parents are stored as Index and ranks, which never exceed the log of the
+// size, as bytes; the size has to fit in an Index.
+template <std::unsigned_integral Index>
+class DSU<size_t, Index> {
  public:
   void Unite(size_t first, size_t second) {
-    size_t first_set = FindSet(first);
-    size_t second_set = FindSet(second);
+    Index first_set = FindSet(first);
+    Index second_set = FindSet(second);
     if (first_set != second_set) {
       if (ranks_[first_set] < ranks_[second_set]) {
         std::swap(first_set, second_set);
@@ -61,6 +249,9 @@ class DSU<size_t> {
     return FindSet(first) == FindSet(second);
   }
   DSU(size_t size) {
+    if (size > std::numeric_limits<Index>::max()) {
+      throw std::length_error("DSU size does not fit the index type");
+    }
     ancestors_.resize(size);
     ranks_.assign(size, 0);
     for (size_t i = 0; i < size; i++) {
@@ -69,62 +260,45 @@ class DSU<size_t> {
   }
 
  private:
-  size_t FindSet(size_t element) {
+  Index FindSet(size_t element) {
     if (element == ancestors_[element]) {
       return element;
     }
     return ancestors_[element] = FindSet(ancestors_[element]);
   }
-  std::vector<size_t> ancestors_;
-  std::vector<size_t> ranks_;
+  std::vector<Index> ancestors_;
+  std::vector<uint8_t> ranks_;
 };
 
-template <typename EType, typename WType>
-class WeightedDSU {
+// Interns the elements once and runs the dense forest on their ids.
+template <typename EType, std::unsigned_integral Index>
+class DSU {
  public:
-  void Unite(const EType& first, const EType& second, const WType& weight) {
-    EType first_set = FindSet(first);
-    EType second_set = FindSet(second);
-    if (first_set != second_set) {
-      if (ranks_[first_set] < ranks_[second_set]) {
-        std::swap(first_set, second_set);
-      }
-      weights_[first_set] += weights_[second_set] + weight;
-      ancestors_[second_set] = first_set;
-      if (ranks_[first_set] == ranks_[second_set]) {
-        ++ranks_[first_set];
-      }
-    } else {
-      weights_[first_set] += weight;
-    }
+  void Unite(const EType& first, const EType& second) {
+    forest_.Unite(ids_.Id(first), ids_.Id(second));
   }
   bool AreSame(const EType& first, const EType& second) {
-    return FindSet(first) == FindSet(second);
-  }
-  WType GetWeight(const EType& element) { return weights_[FindSet(element)]; }
-  WeightedDSU(const std::vector<EType>& elements) : ancestors_(elements) {
-    ranks_.assign(elements.size(), 0);
-    weights_.assign(elements.size(), 0);
+    return forest_.AreSame(ids_.Id(first), ids_.Id(second));
   }
+  DSU(const std::vector<EType>& elements)
+      : ids_(elements), forest_(ids_.Size()) {}
 
  private:
-  EType FindSet(const EType& element) {
-    if (element == ancestors_[element]) {
-      return element;
-    }
-    return ancestors_[element] = FindSet(ancestors_[element]);
-  }
-  std::unordered_map<EType, EType> ancestors_;
-  std::unordered_map<EType, size_t> ranks_;
-  std::unordered_map<EType, WType> weights_;
+  Interner<EType> ids_;
+  DSU<size_t, Index> forest_;
 };
 
-template <typename WType>
-class WeightedDSU<size_t, WType> {
+template <typename EType, typename WType,
+          std::unsigned_integral Index = uint32_t>
+class WeightedDSU;
+
+// The same layout as DSU<size_t, Index>, plus the weight of every set.
+template <typename WType, std::unsigned_integral Index>
+class WeightedDSU<size_t, WType, Index> {
  public:
   void Unite(const size_t& first, const size_t& second, const WType& weight) {
-    size_t first_set = FindSet(first);
-    size_t second_set = FindSet(second);
+    Index first_set = FindSet(first);
+    Index second_set = FindSet(second);
     if (first_set != second_set) {
       if (ranks_[first_set] < ranks_[second_set]) {
         std::swap(first_set, second_set);
@@ -143,6 +317,9 @@ class WeightedDSU<size_t, WType> {
   }
   WType GetWeight(const size_t& element) { return weights_[FindSet(element)]; }
   WeightedDSU(size_t size) {
+    if (size > std::numeric_limits<Index>::max()) {
+      throw std::length_error("DSU size does not fit the index type");
+    }
     weights_.assign(size, 0);
     ancestors_.assign(size, 0);
     ranks_.assign(size, 0);
@@ -152,17 +329,38 @@ class WeightedDSU<size_t, WType> {
   }
 
  private:
-  size_t FindSet(const size_t& element) {
+  Index FindSet(const size_t& element) {
     if (element == ancestors_[element]) {
       return element;
     }
     return ancestors_[element] = FindSet(ancestors_[element]);
   }
-  std::vector<size_t> ancestors_;
-  std::vector<size_t> ranks_;
+  std::vector<Index> ancestors_;
+  std::vector<uint8_t> ranks_;
   std::vector<WType> weights_;
 };
 
+// Interns the elements once and runs the dense forest on their ids.
+template <typename EType, typename WType, std::unsigned_integral Index>
+class WeightedDSU {
+ public:
+  void Unite(const EType& first, const EType& second, const WType& weight) {
+    forest_.Unite(ids_.Id(first), ids_.Id(second), weight);
+  }
+  bool AreSame(const EType& first, const EType& second) {
+    return forest_.AreSame(ids_.Id(first), ids_.Id(second));
+  }
+  WType GetWeight(const EType& element) {
+    return forest_.GetWeight(ids_.Id(element));
+  }
+  WeightedDSU(const std::vector<EType>& elements)
+      : ids_(elements), forest_(ids_.Size()) {}
+
+ private:
+  Interner<EType> ids_;
+  WeightedDSU<size_t, WType, Index> forest_;
+};
+
 struct Edge {
   size_t from;
   size_t to;
@@ -185,13 +383,12 @@ void DFS(size_t begin,
 }
 
 int main() {
-  std::ios_base::sync_with_stdio(false);
-  std::cin.tie(nullptr);
-  std::cout.tie(nullptr);
+  FastInput input;
+  FastOutput output;
   size_t vertex_count;
   size_t edge_count;
   size_t query_count;
-  std::cin >> vertex_count >> edge_count >> query_count;
+  input >> vertex_count >> edge_count >> query_count;
   std::vector<Edge> edges;
   std::vector<std::vector<std::pair<size_t, size_t>>> spanning_tree(
       vertex_count, std::vector<std::pair<size_t, size_t>>());
@@ -199,7 +396,7 @@ int main() {
     size_t from;
     size_t to;
     size_t weight;
-    std::cin >> from >> to >> weight;
+    input >> from >> to >> weight;
     --from;
     --to;
     edges.emplace_back(from, to, weight);
@@ -221,10 +418,10 @@ int main() {
   for(size_t i = 0; i < query_count; i++) {
     size_t first;
     size_t second;
-    std::cin >> first >> second;
+    input >> first >> second;
     --first;
     --second;
-    std::cout << results[first][second] << '\n';
+    output << results[first][second] << '\n';
   }
   return 0;
 }
\ No newline at end of file
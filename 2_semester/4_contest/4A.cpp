@@ -1,22 +1,183 @@
-#include <iostream>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstdlib>
 #include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
 static constexpr int64_t kInfinity = std::numeric_limits<int64_t>::max();
 
+// Vertex and edge ids are stored as Index, so the vertex count and twice the
+// edge count have to fit in it.
+template <std::unsigned_integral Index>
 struct Edge {
-  int64_t to_vertex;
+  Index to_vertex;
   int64_t capacity;
   int64_t flow;
 
   int64_t CurrentCapacity() const { return capacity - flow; }
 
-  Edge(int64_t to_vertex, int64_t capacity)
+  Edge(Index to_vertex, int64_t capacity)
       : to_vertex(to_vertex), capacity(capacity), flow(0) {}
 };
 
-void AddEdge(std::vector<std::vector<int64_t>>& graph, std::vector<Edge>& edges,
-             int64_t from, int64_t to, int64_t capacity) {
+template <std::unsigned_integral Index>
+void AddEdge(std::vector<std::vector<Index>>& graph,
+             std::vector<Edge<Index>>& edges, Index from, Index to,
+             int64_t capacity) {
   --from;
   --to;
   edges.emplace_back(to, capacity);
@@ -25,21 +186,23 @@ void AddEdge(std::vector<std::vector<int64_t>>& graph, std::vector<Edge>& edges,
   graph[to].emplace_back(edges.size() - 1);
 }
 
+template <std::unsigned_integral Index>
 struct State {
   size_t phase;
-  int64_t current;
-  int64_t end;
+  Index current;
+  Index end;
   int64_t min;
 };
 
-int64_t FindIncreasingPath(std::vector<std::vector<int64_t>>& graph,
-                           std::vector<Edge>& edges, std::vector<size_t>& used,
-                           State state) {
+template <std::unsigned_integral Index>
+int64_t FindIncreasingPath(std::vector<std::vector<Index>>& graph,
+                           std::vector<Edge<Index>>& edges,
+                           std::vector<size_t>& used, State<Index> state) {
   if (state.end == state.current) {
     return state.min;
   }
   used[state.current] = state.phase;
-  for (int64_t edge_id : graph[state.current]) {
+  for (Index edge_id : graph[state.current]) {
     if (edges[edge_id].CurrentCapacity() > 0 &&
         used[edges[edge_id].to_vertex] != state.phase) {
       int64_t delta = FindIncreasingPath(
@@ -56,8 +219,9 @@ int64_t FindIncreasingPath(std::vector<std::vector<int64_t>>& graph,
   return 0;
 }
 
-int64_t MaxFlow(std::vector<std::vector<int64_t>>& graph,
-                std::vector<Edge>& edges, int64_t start, int64_t end) {
+template <std::unsigned_integral Index>
+int64_t MaxFlow(std::vector<std::vector<Index>>& graph,
+                std::vector<Edge<Index>>& edges, Index start, Index end) {
   std::vector<size_t> used(graph.size(), 0);
   size_t phase = 1;
   while (FindIncreasingPath(graph, edges, used,
@@ -66,47 +230,64 @@ int64_t MaxFlow(std::vector<std::vector<int64_t>>& graph,
   }
 
   int64_t result = 0;
-  for (int64_t edge_id : graph[start]) {
+  for (Index edge_id : graph[start]) {
     result += edges[edge_id].flow;
   }
   return result;
 }
 
-int main() {
-  std::vector<Edge> edges;
-  int64_t vertex_count;
-  int64_t edge_count;
-  std::cin >> vertex_count >> edge_count;
-  std::vector<std::vector<int64_t>> graph(vertex_count, std::vector<int64_t>());
-  for (int64_t i = 0; i < edge_count; ++i) {
-    int64_t from;
-    int64_t to;
+template <std::unsigned_integral Index>
+void Solve(size_t vertex_count, size_t edge_count, FastInput& input,
+           FastOutput& output) {
+  std::vector<Edge<Index>> edges;
+  std::vector<std::vector<Index>> graph(vertex_count, std::vector<Index>());
+  for (size_t i = 0; i < edge_count; ++i) {
+    Index from;
+    Index to;
     int64_t capacity;
-    std::cin >> from >> to >> capacity;
+    input >> from >> to >> capacity;
     AddEdge(graph, edges, from, to, capacity);
   }
-  std::cout << MaxFlow(graph, edges, 0, vertex_count - 1);
+  output << MaxFlow<Index>(graph, edges, 0, vertex_count - 1);
+}
+
+int main() {
+  FastInput input;
+  FastOutput output;
+  size_t vertex_count;
+  size_t edge_count;
+  input >> vertex_count >> edge_count;
+  if (vertex_count <= std::numeric_limits<uint32_t>::max() &&
+      edge_count <= std::numeric_limits<uint32_t>::max() / 2) {
+    Solve<uint32_t>(vertex_count, edge_count, input, output);
+  } else {
+    Solve<uint64_t>(vertex_count, edge_count, input, output);
+  }
   return 0;
 }
-#include <iostream>
 #include <limits>
 #include <vector>
 
 static constexpr int64_t kInfinity = std::numeric_limits<int64_t>::max();
 
+// Vertex and edge ids are stored as Index, so the vertex count and twice the
+// edge count have to fit in it.
+template <std::unsigned_integral Index>
 struct Edge {
-  int64_t to_vertex;
+  Index to_vertex;
   int64_t capacity;
   int64_t flow;
 
   int64_t CurrentCapacity() const { return capacity - flow; }
 
-  Edge(int64_t to_vertex, int64_t capacity)
+  Edge(Index to_vertex, int64_t capacity)
       : to_vertex(to_vertex), capacity(capacity), flow(0) {}
 };
 
-void AddEdge(std::vector<std::vector<int64_t>>& graph, std::vector<Edge>& edges,
-             int64_t from, int64_t to, int64_t capacity) {
+template <std::unsigned_integral Index>
+void AddEdge(std::vector<std::vector<Index>>& graph,
+             std::vector<Edge<Index>>& edges, Index from, Index to,
+             int64_t capacity) {
   --from;
   --to;
   edges.emplace_back(to, capacity);
@@ -115,21 +296,23 @@ void AddEdge(std::vector<std::vector<int64_t>>& graph, std::vector<Edge>& edges,
   graph[to].emplace_back(edges.size() - 1);
 }
 
+template <std::unsigned_integral Index>
 struct State {
   size_t phase;
-  int64_t current;
-  int64_t end;
+  Index current;
+  Index end;
   int64_t min;
 };
 
-int64_t FindIncreasingPath(std::vector<std::vector<int64_t>>& graph,
-                           std::vector<Edge>& edges, std::vector<size_t>& used,
-                           State state) {
+template <std::unsigned_integral Index>
+int64_t FindIncreasingPath(std::vector<std::vector<Index>>& graph,
+                           std::vector<Edge<Index>>& edges,
+                           std::vector<size_t>& used, State<Index> state) {
   if (state.end == state.current) {
     return state.min;
   }
   used[state.current] = state.phase;
-  for (int64_t edge_id : graph[state.current]) {
+  for (Index edge_id : graph[state.current]) {
     if (edges[edge_id].CurrentCapacity() > 0 &&
         used[edges[edge_id].to_vertex] != state.phase) {
       int64_t delta = FindIncreasingPath(
@@ -146,8 +329,9 @@ int64_t FindIncreasingPath(std::vector<std::vector<int64_t>>& graph,
   return 0;
 }
 
-int64_t MaxFlow(std::vector<std::vector<int64_t>>& graph,
-                std::vector<Edge>& edges, int64_t start, int64_t end) {
+template <std::unsigned_integral Index>
+int64_t MaxFlow(std::vector<std::vector<Index>>& graph,
+                std::vector<Edge<Index>>& edges, Index start, Index end) {
   std::vector<size_t> used(graph.size(), 0);
   size_t phase = 1;
   while (FindIncreasingPath(graph, edges, used,
@@ -156,25 +340,38 @@ int64_t MaxFlow(std::vector<std::vector<int64_t>>& graph,
   }
 
   int64_t result = 0;
-  for (int64_t edge_id : graph[start]) {
+  for (Index edge_id : graph[start]) {
     result += edges[edge_id].flow;
   }
   return result;
 }
 
-int main() {
-  std::vector<Edge> edges;
-  int64_t vertex_count;
-  int64_t edge_count;
-  std::cin >> vertex_count >> edge_count;
-  std::vector<std::vector<int64_t>> graph(vertex_count, std::vector<int64_t>());
-  for (int64_t i = 0; i < edge_count; ++i) {
-    int64_t from;
-    int64_t to;
+template <std::unsigned_integral Index>
+void Solve(size_t vertex_count, size_t edge_count, FastInput& input,
+           FastOutput& output) {
+  std::vector<Edge<Index>> edges;
+  std::vector<std::vector<Index>> graph(vertex_count, std::vector<Index>());
+  for (size_t i = 0; i < edge_count; ++i) {
+    Index from;
+    Index to;
     int64_t capacity;
-    std::cin >> from >> to >> capacity;
+    input >> from >> to >> capacity;
     AddEdge(graph, edges, from, to, capacity);
   }
-  std::cout << MaxFlow(graph, edges, 0, vertex_count - 1);
+  output << MaxFlow<Index>(graph, edges, 0, vertex_count - 1);
+}
+
+int main() {
+  FastInput input;
+  FastOutput output;
+  size_t vertex_count;
+  size_t edge_count;
+  input >> vertex_count >> edge_count;
+  if (vertex_count <= std::numeric_limits<uint32_t>::max() &&
+      edge_count <= std::numeric_limits<uint32_t>::max() / 2) {
+    Solve<uint32_t>(vertex_count, edge_count, input, output);
+  } else {
+    Solve<uint64_t>(vertex_count, edge_count, input, output);
+  }
   return 0;
 }
@@ -1,9 +1,164 @@
-#include <iostream>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstdlib>
 #include <limits>
 #include <set>
-#include <unordered_map>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
 static constexpr int64_t kInfinity = std::numeric_limits<int64_t>::max();
 
 struct Edge {
@@ -11,18 +166,19 @@ struct Edge {
   int64_t to_vertex;
   int64_t capacity;
   int64_t flow;
+  int64_t id;
 
   int64_t CurrentCapacity() const { return capacity - flow; }
 
-  Edge(int64_t to_vertex, int64_t capacity, int64_t from)
-      : from(from), to_vertex(to_vertex), capacity(capacity), flow(0) {}
+  Edge(int64_t to_vertex, int64_t capacity, int64_t from, int64_t id)
+      : from(from), to_vertex(to_vertex), capacity(capacity), flow(0), id(id) {}
 };
 
 void AddEdge(std::vector<std::vector<int64_t>>& graph, std::vector<Edge>& edges,
-             int64_t from, int64_t to, int64_t capacity) {
-  edges.emplace_back(to, capacity, from);
+             int64_t from, int64_t to, int64_t capacity, int64_t id) {
+  edges.emplace_back(to, capacity, from, id);
   graph[from].emplace_back(edges.size() - 1);
-  edges.emplace_back(from, 0, to);
+  edges.emplace_back(from, 0, to, id);
   graph[to].emplace_back(edges.size() - 1);
 }
 
@@ -86,29 +242,24 @@ void FindConnected(std::vector<std::vector<int64_t>>& graph,
 }
 
 void Main2() {  // Прошёл всего год, ~~а у меня борода~~, встречайте Мейн 2!
+  FastInput input;
+  FastOutput output;
   std::vector<Edge> edges;
   int64_t vertex_count;
   int64_t edge_count;
-  std::cin >> vertex_count >> edge_count;
-  std::unordered_map<int64_t, std::unordered_map<int64_t, int64_t>> edge_ids;
+  input >> vertex_count >> edge_count;
   std::vector<std::vector<int64_t>> graph(vertex_count + edge_count,
                                           std::vector<int64_t>());
   for (int64_t i = 0; i < edge_count; ++i) {
     int64_t from;
     int64_t to;
     int64_t capacity;
-    std::cin >> from >> to >> capacity;
+    input >> from >> to >> capacity;
     --from;
     --to;
-    AddEdge(graph, edges, from, to, capacity);
-    AddEdge(graph, edges, to, vertex_count + i, capacity);
-    AddEdge(graph, edges, vertex_count + i, from, capacity);
-    edge_ids[from][to] = i + 1;
-    edge_ids[to][from] = i + 1;
-    edge_ids[to][vertex_count + i] = i + 1;
-    edge_ids[vertex_count + i][to] = i + 1;
-    edge_ids[vertex_count + i][from] = i + 1;
-    edge_ids[from][vertex_count + i] = i + 1;
+    AddEdge(graph, edges, from, to, capacity, i + 1);
+    AddEdge(graph, edges, to, vertex_count + i, capacity, i + 1);
+    AddEdge(graph, edges, vertex_count + i, from, capacity, i + 1);
   }
 
   int64_t max_flow = MaxFlow(graph, edges, 0, vertex_count - 1);
@@ -117,12 +268,12 @@ void Main2() {  // Прошёл всего год, ~~а у меня борода
   std::set<int64_t> answer;
   for (Edge edge : edges) {
     if (used[edge.from] != used[edge.to_vertex]) {
-      answer.insert(edge_ids[edge.from][edge.to_vertex]);
+      answer.insert(edge.id);
     }
   }
-  std::cout << answer.size() << ' ' << max_flow << '\n';
+  output << answer.size() << ' ' << max_flow << '\n';
   for (int64_t ans : answer) {
-    std::cout << ans << ' ';
+    output << ans << ' ';
   }
 };
 
@@ -1,68 +1,421 @@
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 #include <algorithm>
-#include <iostream>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
 #include <limits>
+#include <numbers>
+#include <numeric>
 #include <queue>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 #include <vector>
 
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
 static constexpr int64_t kInfinity = std::numeric_limits<int64_t>::max();
 
+template <std::unsigned_integral Index>
 struct Edge {
-  int64_t from;
-  int64_t to;
+  Index from;
+  Index to;
   int64_t flow;
   int64_t capacity;
 
-  Edge(int64_t from, int64_t to, int64_t capacity)
+  Edge(Index from, Index to, int64_t capacity)
       : from(from), to(to), flow(0), capacity(capacity) {}
 
-  Edge(int64_t from, int64_t to, int64_t flow, int64_t capacity)
+  Edge(Index from, Index to, int64_t flow, int64_t capacity)
       : from(from), to(to), flow(flow), capacity(capacity) {}
 };
 
+// A binary graph record is a BinaryGraphHeader followed by the CSR arrays
+// offsets[id_bound + 1] and neighbours[arc_count], then weights[arc_count]
+// if kWeighted and, if kEdgeIds, the index of the input edge behind every
+// arc. Every field is a native-endian 64-bit word, so a mapped file is used
+// in place; records may follow each other in one file.
+struct BinaryGraphHeader {
+  static constexpr uint64_t kMagic = 0x3152534348505247;  // "GRPHCSR1"
+  static constexpr uint32_t kUndirected = 1;
+  static constexpr uint32_t kWeighted = 2;
+  static constexpr uint32_t kEdgeIds = 4;
+
+  uint64_t magic = kMagic;
+  uint32_t flags = 0;
+  uint32_t reserved = 0;
+  uint64_t vertex_count = 0;
+  uint64_t id_bound = 0;
+  uint64_t edge_count = 0;
+  uint64_t arc_count = 0;
+  uint64_t source = 0;
+  uint64_t sink = 0;
+};
+
+class BinaryGraph {
+ public:
+  explicit BinaryGraph(std::span<const std::byte> data) {
+    if (data.size() < sizeof(BinaryGraphHeader)) {
+      throw std::runtime_error("truncated graph header");
+    }
+    header_ = reinterpret_cast<const BinaryGraphHeader*>(data.data());
+    if (header_->magic != BinaryGraphHeader::kMagic) {
+      throw std::runtime_error("not a binary graph");
+    }
+    const auto* words = reinterpret_cast<const uint64_t*>(header_ + 1);
+    size_t arcs = header_->arc_count;
+    offsets_ = {words, header_->id_bound + 1};
+    words += offsets_.size();
+    neighbours_ = {words, arcs};
+    words += arcs;
+    if (header_->flags & BinaryGraphHeader::kWeighted) {
+      weights_ = {reinterpret_cast<const int64_t*>(words), arcs};
+      words += arcs;
+    }
+    if (header_->flags & BinaryGraphHeader::kEdgeIds) {
+      edge_ids_ = {words, arcs};
+      words += arcs;
+    }
+    byte_size_ = reinterpret_cast<const std::byte*>(words) - data.data();
+    if (byte_size_ > data.size()) {
+      throw std::runtime_error("truncated graph");
+    }
+  }
+  const BinaryGraphHeader& Header() const { return *header_; }
+  std::span<const uint64_t> Offsets() const { return offsets_; }
+  std::span<const uint64_t> Neighbours() const { return neighbours_; }
+  std::span<const int64_t> Weights() const { return weights_; }
+  std::span<const uint64_t> EdgeIds() const { return edge_ids_; }
+  // The next record, if any, starts this many bytes after the header.
+  size_t ByteSize() const { return byte_size_; }
+
+ private:
+  const BinaryGraphHeader* header_;
+  std::span<const uint64_t> offsets_;
+  std::span<const uint64_t> neighbours_;
+  std::span<const int64_t> weights_;
+  std::span<const uint64_t> edge_ids_;
+  size_t byte_size_;
+};
+
+class MappedFile {
+ public:
+  explicit MappedFile(const char* path) {
+    int descriptor = open(path, O_RDONLY);
+    if (descriptor < 0) {
+      throw std::system_error(errno, std::generic_category(), path);
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0) {
+      int error = errno;
+      close(descriptor);
+      throw std::system_error(error, std::generic_category(), path);
+    }
+    size_ = status.st_size;
+    if (size_ > 0) {
+      data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    }
+    int error = errno;
+    close(descriptor);
+    if (data_ == MAP_FAILED) {
+      throw std::system_error(error, std::generic_category(), path);
+    }
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile() {
+    if (size_ > 0) {
+      munmap(data_, size_);
+    }
+  }
+  std::span<const std::byte> Bytes() const {
+    return {static_cast<const std::byte*>(data_), size_};
+  }
+
+ private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Arcs of a vertex keep the input order of their edges, as CSRListGraph
+// lays them out; weights may be empty unless kWeighted is set.
+void WriteBinaryGraph(std::ostream& output, BinaryGraphHeader header,
+                      const std::vector<std::pair<uint64_t, uint64_t>>& edges,
+                      const std::vector<int64_t>& weights) {
+  bool undirected = header.flags & BinaryGraphHeader::kUndirected;
+  std::vector<uint64_t> offsets(header.id_bound + 1, 0);
+  for (auto edge : edges) {
+    ++offsets[edge.first + 1];
+    if (undirected) {
+      ++offsets[edge.second + 1];
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  header.edge_count = edges.size();
+  header.arc_count = offsets.back();
+  std::vector<uint64_t> neighbours(header.arc_count);
+  std::vector<int64_t> arc_weights(header.arc_count);
+  std::vector<uint64_t> edge_ids(header.arc_count);
+  std::vector<uint64_t> fill(offsets.begin() + 1, offsets.end());
+  auto place = [&](uint64_t from, uint64_t to, size_t index) {
+    size_t arc = --fill[from];
+    neighbours[arc] = to;
+    arc_weights[arc] = weights.empty() ? 0 : weights[index];
+    edge_ids[arc] = index;
+  };
+  for (size_t i = edges.size(); i > 0; i--) {
+    if (undirected) {
+      place(edges[i - 1].second, edges[i - 1].first, i - 1);
+    }
+    place(edges[i - 1].first, edges[i - 1].second, i - 1);
+  }
+  auto write = [&output](const void* data, size_t size) {
+    output.write(static_cast<const char*>(data),
+                 static_cast<std::streamsize>(size));
+  };
+  write(&header, sizeof(header));
+  write(offsets.data(), offsets.size() * sizeof(uint64_t));
+  write(neighbours.data(), neighbours.size() * sizeof(uint64_t));
+  if (header.flags & BinaryGraphHeader::kWeighted) {
+    write(arc_weights.data(), arc_weights.size() * sizeof(int64_t));
+  }
+  if (header.flags & BinaryGraphHeader::kEdgeIds) {
+    write(edge_ids.data(), edge_ids.size() * sizeof(uint64_t));
+  }
+  if (!output) {
+    throw std::runtime_error("failed to write graph");
+  }
+}
+
+// Vertex ids, arc ids and the per-vertex arrays of Dinic are stored as
+// Index, so the vertex count and twice the edge count have to fit in it.
+template <std::unsigned_integral Index = uint32_t>
 class Graph {
  public:
-  Graph(size_t size) : graph_(size, std::vector<size_t>()) {}
+  static constexpr Index kUnreached = std::numeric_limits<Index>::max();
+
+  Graph(size_t size) : vertex_count_(size) {}
+
+  // Capacities and endpoints come straight from a directed weighted record
+  // with edge ids; only the residual edges, whose flow changes, are copied.
+  explicit Graph(const BinaryGraph& graph)
+      : vertex_count_(graph.Header().vertex_count),
+        edges_(2 * graph.Header().edge_count, Edge<Index>(0, 0, 0)),
+        ids_(graph.Header().edge_count) {
+    std::span<const uint64_t> offsets = graph.Offsets();
+    for (size_t from = 0; from + 1 < offsets.size(); from++) {
+      for (size_t arc = offsets[from]; arc < offsets[from + 1]; arc++) {
+        size_t edge_id = 2 * graph.EdgeIds()[arc];
+        Index to = (Index)graph.Neighbours()[arc];
+        edges_[edge_id] = Edge<Index>((Index)from, to, graph.Weights()[arc]);
+        edges_[edge_id + 1] = Edge<Index>(to, (Index)from, 0);
+        ids_[edge_id / 2] = (Index)edge_id;
+      }
+    }
+    BuildArcs();
+  }
 
-  void AddEdge(int64_t from, int64_t to, int64_t capacity) {
+  void AddEdge(Index from, Index to, int64_t capacity) {
     edges_.emplace_back(from, to, capacity);
     size_t edge_id = edges_.size() - 1;
-    ids_.push_back((int64_t)edge_id);
+    ids_.push_back((Index)edge_id);
     edges_.emplace_back(to, from, 0);
-    size_t back_edge_id = edges_.size() - 1;
-    graph_[from].push_back(edge_id);
-    graph_[to].push_back(back_edge_id);
   }
 
   bool BFS(size_t start, size_t end) {
-    dist_.assign(graph_.size(), kInfinity);
-    std::queue<size_t> queue;
+    dist_.assign(vertex_count_, kUnreached);
+    std::queue<Index> queue;
     dist_[start] = 0;
     queue.push(start);
-    while (!queue.empty() && dist_[end] == kInfinity) {
-      size_t vertex = queue.front();
+    while (!queue.empty() && dist_[end] == kUnreached) {
+      Index vertex = queue.front();
       queue.pop();
-      for (unsigned long id : graph_[vertex]) {
-        if (dist_[edges_[id].to] == kInfinity &&
+      for (Index id : Arcs(vertex)) {
+        if (dist_[edges_[id].to] == kUnreached &&
             edges_[id].flow < edges_[id].capacity) {
           queue.push(edges_[id].to);
           dist_[edges_[id].to] = dist_[edges_[id].from] + 1;
         }
       }
     }
-    return dist_[end] != kInfinity;  // увы ниче не нашли!
+    return dist_[end] != kUnreached;  // увы ниче не нашли!
   }
 
   int64_t DFS(size_t vertex, size_t end, int64_t current_flow,
-              std::vector<int64_t>& ptr) {
+              std::vector<Index>& ptr) {
     if (current_flow <= 0) {
       return 0;
     }
     if (vertex == end) {
       return current_flow;
     }
-    for (int64_t i = ptr[vertex]; i < (int64_t)graph_[vertex].size(); i++) {
-      auto to_id = (int64_t)graph_[vertex][i];
-      size_t to = edges_[to_id].to;
+    std::span<const Index> arcs = Arcs(vertex);
+    for (size_t i = ptr[vertex]; i < arcs.size(); i++) {
+      Index to_id = arcs[i];
+      Index to = edges_[to_id].to;
       if (dist_[to] == dist_[vertex] + 1) {
         int64_t flow = DFS(
             to, end,
@@ -82,9 +435,16 @@ class Graph {
   int64_t GetFlow(size_t edge_id) { return edges_[ids_[edge_id]].flow; }
 
   int64_t DinicAlgo(size_t start, size_t end) {
+    if (offsets_.empty() || arcs_.size() != edges_.size()) {
+      BuildArcs();
+    }
+    if (!new_ids_.empty()) {
+      start = new_ids_[start];
+      end = new_ids_[end];
+    }
     int64_t flow = 0;
     while (BFS(start, end)) {
-      std::vector<int64_t> ptr(graph_.size(), 0);
+      std::vector<Index> ptr(vertex_count_, 0);
       int64_t delta = 0;
       do {
         delta = DFS(start, end, kInfinity, ptr);
@@ -94,37 +454,399 @@ class Graph {
     return flow;
   }
 
+  // Residual edges by tail, in id order as AddEdge created them.
+  void BuildArcs() {
+    offsets_.assign(vertex_count_ + 1, 0);
+    for (const Edge<Index>& edge : edges_) {
+      ++offsets_[edge.from + 1];
+    }
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    arcs_.resize(edges_.size());
+    std::vector<size_t> fill(offsets_.begin(), offsets_.end() - 1);
+    for (size_t id = 0; id < edges_.size(); id++) {
+      arcs_[fill[edges_[id].from]++] = (Index)id;
+    }
+  }
+
+  // Relabels the vertices by reverse Cuthill-McKee over the residual arcs.
+  // Arcs of a vertex keep their order, so Dinic makes the same choices, and
+  // DinicAlgo keeps taking the original ids.
+  void Reorder() {
+    BuildArcs();
+    auto by_degree = [this](size_t first, size_t second) {
+      return Arcs(first).size() < Arcs(second).size();
+    };
+    std::vector<size_t> roots(vertex_count_);
+    std::iota(roots.begin(), roots.end(), 0);
+    std::stable_sort(roots.begin(), roots.end(), by_degree);
+    std::vector<size_t> order;
+    order.reserve(vertex_count_);
+    std::vector<bool> placed(vertex_count_, false);
+    for (size_t root : roots) {
+      if (placed[root]) {
+        continue;
+      }
+      placed[root] = true;
+      order.push_back(root);
+      for (size_t head = order.size() - 1; head < order.size(); head++) {
+        size_t begin = order.size();
+        for (Index id : Arcs(order[head])) {
+          if (!placed[edges_[id].to]) {
+            placed[edges_[id].to] = true;
+            order.push_back(edges_[id].to);
+          }
+        }
+        std::stable_sort(order.begin() + begin, order.end(), by_degree);
+      }
+    }
+    std::vector<Index> relabel(vertex_count_);
+    for (size_t i = 0; i < vertex_count_; i++) {
+      relabel[order[vertex_count_ - 1 - i]] = (Index)i;
+    }
+    for (Edge<Index>& edge : edges_) {
+      edge.from = relabel[edge.from];
+      edge.to = relabel[edge.to];
+    }
+    if (new_ids_.empty()) {
+      new_ids_ = std::move(relabel);
+    } else {
+      for (Index& id : new_ids_) {
+        id = relabel[id];
+      }
+    }
+    BuildArcs();
+  }
+
  private:
-  std::vector<Edge> edges_;
-  std::vector<std::vector<size_t>> graph_;
-  std::vector<int64_t> dist_;
-  std::vector<int64_t> ids_;
+  std::span<const Index> Arcs(size_t vertex) const {
+    return {arcs_.data() + offsets_[vertex],
+            arcs_.data() + offsets_[vertex + 1]};
+  }
+
+  size_t vertex_count_;
+  std::vector<Edge<Index>> edges_;
+  std::vector<size_t> offsets_;
+  std::vector<Index> arcs_;
+  std::vector<Index> dist_;
+  std::vector<Index> ids_;
+  std::vector<Index> new_ids_;
 };
 
-void Main2() {
-  std::ios_base::sync_with_stdio(false);
-  std::cin.tie(nullptr);
-  std::cout.tie(nullptr);
-  size_t vertex_count;
-  size_t edge_count;
-  std::cin >> vertex_count >> edge_count;
-  Graph gr(vertex_count);
+// Counts the hardware cache misses of the calling thread between Start and
+// Stop through perf_event_open; Misses() is -1 where the kernel or the
+// machine does not expose the counter.
+class CacheMissCounter {
+ public:
+  CacheMissCounter() {
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    descriptor_ = static_cast<int>(
+        syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+  }
+  CacheMissCounter(const CacheMissCounter&) = delete;
+  CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+  ~CacheMissCounter() {
+    if (descriptor_ >= 0) {
+      close(descriptor_);
+    }
+  }
+  void Start() {
+    if (descriptor_ >= 0) {
+      ioctl(descriptor_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(descriptor_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+  void Stop() {
+    if (descriptor_ >= 0) {
+      ioctl(descriptor_, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  int64_t Misses() const {
+    uint64_t count = 0;
+    if (descriptor_ < 0 ||
+        read(descriptor_, &count, sizeof(count)) != sizeof(count)) {
+      return -1;
+    }
+    return static_cast<int64_t>(count);
+  }
+
+ private:
+  int descriptor_;
+};
+
+// Runs kernel once and prints its wall time and cache misses as one JSON
+// object per line.
+template <class Kernel>
+void ReportKernel(std::string_view name, std::string_view order,
+                  Kernel&& kernel, FastOutput& output) {
+  CacheMissCounter counter;
+  auto begin = std::chrono::steady_clock::now();
+  counter.Start();
+  kernel();
+  counter.Stop();
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  output << "{\"kernel\": \"" << name << "\", \"order\": \"" << order
+         << "\", \"microseconds\": "
+         << std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+                .count()
+         << ", \"cache_misses\": " << counter.Misses() << "}\n";
+}
+
+// Runs kernel once on a synthetic input and prints its throughput as one
+// JSON object per line; count is the number of units the kernel processed.
+template <class Kernel>
+void ReportThroughput(std::string_view name, std::string_view generator,
+                      size_t size, std::string_view unit, size_t count,
+                      Kernel&& kernel, FastOutput& output) {
+  auto begin = std::chrono::steady_clock::now();
+  kernel();
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  uint64_t microseconds = std::max<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(),
+      1);
+  output << "{\"kernel\": \"" << name << "\", \"generator\": \"" << generator
+         << "\", \"size\": " << size << ", \"" << unit << "\": " << count
+         << ", \"microseconds\": " << microseconds << ", \"" << unit
+         << "_per_second\": " << count * 1000000 / microseconds << "}\n";
+}
+
+// Deterministic synthetic graphs for the benchmarks: the same generator,
+// vertex count and seed always give the same edges over [0, vertex_count).
+// "rmat" is a power-law R-MAT graph and "geometric" joins random points of
+// the unit square that are close enough for about eight neighbours each;
+// "grid" is the largest square 4-neighbour grid that fits and "path" one
+// long path.
+std::vector<std::pair<size_t, size_t>> SyntheticEdges(
+    std::string_view generator, size_t vertex_count, uint64_t seed = 1) {
+  static constexpr size_t kDegree = 8;
+  std::mt19937_64 random(seed);
+  auto unit = [&random]() {
+    return static_cast<double>(random() >> 11) * 0x1p-53;
+  };
+  std::vector<std::pair<size_t, size_t>> edges;
+  if (generator == "rmat") {
+    size_t scale = std::bit_width(std::max<size_t>(vertex_count, 2) - 1);
+    edges.reserve(vertex_count * kDegree / 2);
+    while (edges.size() < vertex_count * kDegree / 2) {
+      size_t from = 0;
+      size_t to = 0;
+      for (size_t bit = 0; bit < scale; bit++) {
+        double quadrant = unit();
+        from = 2 * from + (quadrant >= 0.76);
+        to = 2 * to + ((quadrant >= 0.57 && quadrant < 0.76) ||
+                       quadrant >= 0.95);
+      }
+      if (from < vertex_count && to < vertex_count) {
+        edges.emplace_back(from, to);
+      }
+    }
+  } else if (generator == "grid") {
+    size_t side = static_cast<size_t>(std::sqrt(vertex_count));
+    while (side * side > vertex_count) {
+      side--;
+    }
+    while ((side + 1) * (side + 1) <= vertex_count) {
+      side++;
+    }
+    for (size_t row = 0; row < side; row++) {
+      for (size_t column = 0; column < side; column++) {
+        size_t vertex = row * side + column;
+        if (column + 1 < side) {
+          edges.emplace_back(vertex, vertex + 1);
+        }
+        if (row + 1 < side) {
+          edges.emplace_back(vertex, vertex + side);
+        }
+      }
+    }
+  } else if (generator == "geometric") {
+    double radius = std::sqrt(kDegree / (std::numbers::pi * vertex_count));
+    size_t cells = std::max<size_t>(1, static_cast<size_t>(1 / radius));
+    std::vector<std::pair<double, double>> points(vertex_count);
+    std::vector<size_t> offsets(cells * cells + 1, 0);
+    auto cell_of = [cells](double coordinate) {
+      return std::min(cells - 1, static_cast<size_t>(coordinate * cells));
+    };
+    for (auto& point : points) {
+      point = {unit(), unit()};
+      ++offsets[cell_of(point.first) * cells + cell_of(point.second) + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<size_t> members(vertex_count);
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < vertex_count; i++) {
+      members[fill[cell_of(points[i].first) * cells +
+                   cell_of(points[i].second)]++] = i;
+    }
+    for (size_t i = 0; i < vertex_count; i++) {
+      size_t row = cell_of(points[i].first);
+      size_t column = cell_of(points[i].second);
+      for (size_t x = row - (row > 0); x <= std::min(row + 1, cells - 1);
+           x++) {
+        for (size_t y = column - (column > 0);
+             y <= std::min(column + 1, cells - 1); y++) {
+          for (size_t k = offsets[x * cells + y];
+               k < offsets[x * cells + y + 1]; k++) {
+            size_t j = members[k];
+            double dx = points[i].first - points[j].first;
+            double dy = points[i].second - points[j].second;
+            if (j > i && dx * dx + dy * dy < radius * radius) {
+              edges.emplace_back(i, j);
+            }
+          }
+        }
+      }
+    }
+  } else if (generator == "path") {
+    for (size_t i = 1; i < vertex_count; i++) {
+      edges.emplace_back(i - 1, i);
+    }
+  } else {
+    throw std::invalid_argument("unknown generator " +
+                                std::string(generator));
+  }
+  return edges;
+}
+
+// True when vertex_count vertices and both arcs of edge_count edges get ids
+// that fit in Index.
+template <std::unsigned_integral Index>
+bool Fits(size_t vertex_count, size_t edge_count) {
+  return vertex_count <= std::numeric_limits<Index>::max() &&
+         edge_count <= std::numeric_limits<Index>::max() / 2;
+}
+
+template <std::unsigned_integral Index>
+void BenchSynthetic(std::string_view name, std::string_view generator,
+                    size_t vertex_count,
+                    const std::vector<std::pair<size_t, size_t>>& edges,
+                    FastOutput& output) {
+  std::mt19937_64 random(2);
+  Graph<Index> gr(vertex_count);
+  size_t sink = 0;
+  for (auto [from, to] : edges) {
+    int64_t capacity = static_cast<int64_t>(random() % 1000) + 1;
+    gr.AddEdge(from, to, capacity);
+    gr.AddEdge(to, from, capacity);
+    sink = std::max({sink, from, to});
+  }
+  gr.BuildArcs();
+  ReportThroughput(
+      name, generator, vertex_count, "edges", edges.size(),
+      [&]() {
+        if (sink != 0) {
+          gr.DinicAlgo(0, sink);
+        }
+      },
+      output);
+}
+
+template <std::unsigned_integral Index>
+void PrintFlow(const BinaryGraph& record, FastOutput& output) {
+  Graph<Index> gr(record);
+  output << gr.DinicAlgo(record.Header().source, record.Header().sink)
+         << '\n';
+  for (size_t i = 0; i < record.Header().edge_count; i++) {
+    output << gr.GetFlow(i) << '\n';
+  }
+}
+
+template <std::unsigned_integral Index>
+void Solve(size_t vertex_count, size_t edge_count, bool bench,
+           FastInput& input, FastOutput& output) {
+  Graph<Index> gr(vertex_count);
   for (size_t i = 0; i < edge_count; ++i) {
-    int64_t from;
-    int64_t to;
+    Index from;
+    Index to;
     int64_t capacity;
-    std::cin >> from >> to >> capacity;
+    input >> from >> to >> capacity;
     --from;
     --to;
     gr.AddEdge(from, to, capacity);
   }
-  std::cout << gr.DinicAlgo(0, vertex_count - 1) << '\n';
+  if (bench) {
+    gr.BuildArcs();
+    Graph<Index> reordered(gr);
+    ReportKernel(
+        "dinic", "input", [&]() { gr.DinicAlgo(0, vertex_count - 1); },
+        output);
+    ReportKernel("relabel", "rcm", [&]() { reordered.Reorder(); }, output);
+    ReportKernel(
+        "dinic", "rcm", [&]() { reordered.DinicAlgo(0, vertex_count - 1); },
+        output);
+    return;
+  }
+  output << gr.DinicAlgo(0, vertex_count - 1) << '\n';
   for (size_t i = 0; i < edge_count; i++) {
-    std::cout << gr.GetFlow(i) << '\n';
+    output << gr.GetFlow(i) << '\n';
   }
 }
 
-int main() {
-  Main2();
+void Main2(int argc, char** argv) {
+  FastOutput output;
+  if (argc == 4 && std::string_view(argv[1]) == "--bench") {
+    size_t vertex_count = std::stoull(argv[3]);
+    std::vector<std::pair<size_t, size_t>> edges =
+        SyntheticEdges(argv[2], vertex_count);
+    BenchSynthetic<uint64_t>("dinic_uint64", argv[2], vertex_count, edges,
+                             output);
+    if (Fits<uint32_t>(vertex_count, 2 * edges.size())) {
+      BenchSynthetic<uint32_t>("dinic_uint32", argv[2], vertex_count, edges,
+                               output);
+    }
+    return;
+  }
+  if (argc == 2 && std::string_view(argv[1]) != "--bench") {
+    MappedFile file(argv[1]);
+    BinaryGraph record(file.Bytes());
+    if (Fits<uint32_t>(record.Header().vertex_count,
+                       record.Header().edge_count)) {
+      PrintFlow<uint32_t>(record, output);
+    } else {
+      PrintFlow<uint64_t>(record, output);
+    }
+    return;
+  }
+  FastInput input;
+  size_t vertex_count;
+  size_t edge_count;
+  input >> vertex_count >> edge_count;
+  if (argc == 3 && std::string_view(argv[1]) == "--convert") {
+    std::vector<std::pair<uint64_t, uint64_t>> edges(edge_count);
+    std::vector<int64_t> capacities(edge_count);
+    for (size_t i = 0; i < edge_count; ++i) {
+      input >> edges[i].first >> edges[i].second >> capacities[i];
+      --edges[i].first;
+      --edges[i].second;
+    }
+    BinaryGraphHeader header;
+    header.flags = BinaryGraphHeader::kWeighted | BinaryGraphHeader::kEdgeIds;
+    header.vertex_count = vertex_count;
+    header.id_bound = vertex_count;
+    header.sink = vertex_count - 1;
+    std::ofstream binary(argv[2], std::ios::binary);
+    WriteBinaryGraph(binary, header, edges, capacities);
+    return;
+  }
+  if (Fits<uint32_t>(vertex_count, edge_count)) {
+    Solve<uint32_t>(vertex_count, edge_count, argc == 2, input, output);
+  } else {
+    Solve<uint64_t>(vertex_count, edge_count, argc == 2, input, output);
+  }
+}
+
+// With no arguments the task reads text from stdin; "--convert file" writes
+// that input as a binary graph record and "file" answers from such a record.
+// "--bench" times the flow on the input order and on the RCM order;
+// "--bench generator size" times it on a synthetic graph with both arcs of
+// every edge, from vertex 0 to the largest vertex with an edge, once with
+// 64-bit and once with 32-bit ids.
+int main(int argc, char** argv) {
+  Main2(argc, argv);
   return 0;
-}
\ No newline at end of file
+}
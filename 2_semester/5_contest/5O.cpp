@@ -1,9 +1,168 @@
-#include <iostream>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <complex>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
-#include <algorithm>
-#include <complex>
+
+// Reads stdin in large read(2) blocks. Integers are parsed straight out of
+// the buffer; words, characters and reals skip whitespace like std::cin.
+class FastInput {
+ public:
+  FastInput() : buffer_(kBufferSize) {}
+  FastInput(const FastInput&) = delete;
+  FastInput& operator=(const FastInput&) = delete;
+  template <std::integral T>
+  FastInput& operator>>(T& value) {
+    bool negative = SkipSpaces() == '-';
+    if (negative) {
+      ++position_;
+    }
+    std::make_unsigned_t<T> result = 0;
+    do {
+      const char* cursor = buffer_.data() + position_;
+      const char* end = buffer_.data() + size_;
+      unsigned digit;
+      while (cursor != end &&
+             (digit = static_cast<unsigned char>(*cursor) - '0') < 10) {
+        result = result * 10 + digit;
+        ++cursor;
+      }
+      position_ = cursor - buffer_.data();
+    } while (position_ == size_ && Refill());
+    value = static_cast<T>(negative ? 0 - result : result);
+    return *this;
+  }
+  FastInput& operator>>(char& symbol) {
+    int next = SkipSpaces();
+    if (next != -1) {
+      symbol = static_cast<char>(next);
+      ++position_;
+    }
+    return *this;
+  }
+  FastInput& operator>>(std::string& word) {
+    word.clear();
+    SkipSpaces();
+    do {
+      size_t begin = position_;
+      while (position_ != size_ &&
+             static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        ++position_;
+      }
+      word.append(buffer_.data() + begin, position_ - begin);
+    } while (position_ == size_ && Refill());
+    return *this;
+  }
+  FastInput& operator>>(double& value) {
+    *this >> word_;
+    value = std::strtod(word_.c_str(), nullptr);
+    return *this;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  bool Refill() {
+    ssize_t count;
+    do {
+      count = read(0, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    position_ = 0;
+    size_ = count > 0 ? static_cast<size_t>(count) : 0;
+    return size_ > 0;
+  }
+  int SkipSpaces() {
+    while (position_ != size_ || Refill()) {
+      if (static_cast<unsigned char>(buffer_[position_]) > ' ') {
+        return buffer_[position_];
+      }
+      ++position_;
+    }
+    return -1;
+  }
+
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  std::string word_;
+};
+
+// Collects stdout in a large buffer that goes out in one write(2) whenever
+// it fills and when the writer is destroyed.
+class FastOutput {
+ public:
+  FastOutput() : buffer_(kBufferSize) {}
+  FastOutput(const FastOutput&) = delete;
+  FastOutput& operator=(const FastOutput&) = delete;
+  ~FastOutput() { Flush(); }
+  template <std::integral T>
+  FastOutput& operator<<(T value) {
+    if (buffer_.size() - size_ < kMaxDigits) {
+      Flush();
+    }
+    char* begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxDigits, value).ptr -
+            buffer_.data();
+    return *this;
+  }
+  FastOutput& operator<<(char symbol) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = symbol;
+    return *this;
+  }
+  FastOutput& operator<<(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      Flush();
+    }
+    if (text.size() > buffer_.size()) {
+      Write(text.data(), text.size());
+      return *this;
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+  }
+  void Flush() {
+    Write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+  static constexpr size_t kMaxDigits = 24;
+
+  static void Write(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t count = write(1, data, size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      data += count;
+      size -= static_cast<size_t>(count);
+    }
+  }
+
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
 
 using namespace std::complex_literals;
 constexpr double PI = 3.1415926535897932384626433832795028841971693993751058209;
@@ -60,24 +219,64 @@ int64_t Round(double num) {
   return num - 0.5;
 }
 
-int main() {
-  std::ios_base::sync_with_stdio(false);
-  std::cin.tie(nullptr);
-  std::cout.tie(nullptr);
+// Runs kernel once on a synthetic input and prints its throughput as one
+// JSON object per line; count is the number of units the kernel processed.
+template <class Kernel>
+void ReportThroughput(std::string_view name, std::string_view generator,
+                      size_t size, std::string_view unit, size_t count,
+                      Kernel&& kernel, FastOutput& output) {
+  auto begin = std::chrono::steady_clock::now();
+  kernel();
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  uint64_t microseconds = std::max<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(),
+      1);
+  output << "{\"kernel\": \"" << name << "\", \"generator\": \"" << generator
+         << "\", \"size\": " << size << ", \"" << unit << "\": " << count
+         << ", \"microseconds\": " << microseconds << ", \"" << unit
+         << "_per_second\": " << count * 1000000 / microseconds << "}\n";
+}
+
+// "--bench random size" transforms a polynomial of random integer
+// coefficients padded to a power of two.
+int main(int argc, char** argv) {
+  FastInput input;
+  FastOutput output;
+  if (argc == 4 && std::string_view(argv[1]) == "--bench") {
+    if (std::string_view(argv[2]) != "random") {
+      throw std::invalid_argument("unknown generator " +
+                                  std::string(argv[2]));
+    }
+    size_t size = std::bit_ceil<size_t>(std::stoull(argv[3]));
+    std::mt19937_64 random(1);
+    std::vector<std::complex<double>> polynomial(size);
+    for (auto& coefficient : polynomial) {
+      coefficient = static_cast<double>(random() % 2001) - 1000;
+    }
+    ReportThroughput(
+        "fft", argv[2], size, "bytes",
+        size * sizeof(std::complex<double>), [&]() { FFT(polynomial); },
+        output);
+    return 0;
+  }
   size_t size_a;
-  std::cin >> size_a;
+  input >> size_a;
   ++size_a;
   std::vector<std::complex<double>> polynomial_a(size_a);
   for (size_t i = 0; i < size_a; i++) {
-    std::cin >> polynomial_a[i];
+    double coefficient;
+    input >> coefficient;
+    polynomial_a[i] = coefficient;
   }
   std::reverse(polynomial_a.begin(), polynomial_a.end());
   size_t size_b;
-  std::cin >> size_b;
+  input >> size_b;
   ++size_b;
   std::vector<std::complex<double>> polynomial_b(size_b);
   for (size_t i = 0; i < size_b; i++) {
-    std::cin >> polynomial_b[i];
+    double coefficient;
+    input >> coefficient;
+    polynomial_b[i] = coefficient;
   }
   std::reverse(polynomial_b.begin(), polynomial_b.end());
   size_t power_of_two = 1;
@@ -97,10 +296,9 @@ int main() {
     polynomial_c[i] = polynomial_a[i] * polynomial_b[i];
   }
   IFFT(polynomial_c);
-  std::cout << size_a + size_b - 2 << ' ';
+  output << size_a + size_b - 2 << ' ';
   for (size_t i = 0; i < size_a + size_b - 1; i++) {
-    std::cout << Round(std::real(polynomial_c[size_a + size_b - 2 - i]))
-              << ' ';
+    output << Round(std::real(polynomial_c[size_a + size_b - 2 - i])) << ' ';
   }
   return 0;
 }
\ No newline at end of file